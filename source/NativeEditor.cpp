@@ -0,0 +1,76 @@
+#include "NativeEditor.h"
+
+namespace
+{
+    // The web UI scales the 500px artwork into a 310px editor
+    constexpr int editorSize = 310;
+}
+
+MiniRiserNativeEditor::Artwork::Artwork()
+{
+    background = juce::ImageCache::getFromMemory(BinaryData::sas2uibg_png, BinaryData::sas2uibg_pngSize);
+    const auto knob = juce::ImageCache::getFromMemory(BinaryData::sas2uiknob_png, BinaryData::sas2uiknob_pngSize);
+
+    // The knob artwork is a full-size overlay; only the centred square around the cap is kept
+    knobArea = knob.getBounds().withSizeKeepingCentre(180, 180);
+    const auto knobCrop = knob.getClippedImage(knobArea);
+    const auto frameSize = knobArea.getWidth();
+    const auto centre = static_cast<float>(frameSize) * 0.5f;
+
+    knobFrames = juce::Image(juce::Image::ARGB, frameSize, frameSize * numKnobFrames, true);
+    juce::Graphics g(knobFrames);
+    g.setImageResamplingQuality(juce::Graphics::highResamplingQuality);
+
+    for (int frame = 0; frame < numKnobFrames; ++frame) {
+        const auto angle = juce::degreesToRadians(maxKnobRotationDegrees * static_cast<float>(frame) / static_cast<float>(numKnobFrames - 1));
+        g.drawImageTransformed(knobCrop, juce::AffineTransform::rotation(angle, centre, centre)
+                                             .translated(0.0f, static_cast<float>(frame * frameSize)));
+    }
+}
+
+void MiniRiserNativeEditor::KnobLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
+                                                             float sliderPosProportional, float, float, juce::Slider&)
+{
+    const auto frameSize = artwork.knobFrames.getWidth();
+    const auto frame = juce::jlimit(0, Artwork::numKnobFrames - 1,
+                                    juce::roundToInt(sliderPosProportional * static_cast<float>(Artwork::numKnobFrames - 1)));
+
+    g.setImageResamplingQuality(juce::Graphics::mediumResamplingQuality);
+    g.drawImage(artwork.knobFrames, x, y, width, height, 0, frame * frameSize, frameSize, frameSize);
+}
+
+//==============================================================================
+MiniRiserNativeEditor::MiniRiserNativeEditor (MiniRiserAudioProcessor& p)
+    : AudioProcessorEditor (&p),
+      impactAttachment{*p.getState().getParameter("impact"), impactKnob}
+{
+    setOpaque(true);
+
+    // Same feel as the web knob: vertical drag, 200px for the full range
+    impactKnob.setSliderStyle(juce::Slider::RotaryVerticalDrag);
+    impactKnob.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
+    impactKnob.setMouseDragSensitivity(200);
+    impactKnob.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    impactKnob.setLookAndFeel(&knobLookAndFeel);
+    addAndMakeVisible(impactKnob);
+
+    setSize (editorSize, editorSize);
+}
+
+MiniRiserNativeEditor::~MiniRiserNativeEditor()
+{
+    impactKnob.setLookAndFeel(nullptr);
+}
+
+void MiniRiserNativeEditor::paint (juce::Graphics& g)
+{
+    g.fillAll(juce::Colour(0xfff0f0f0));
+    g.drawImage(artwork->background, getLocalBounds().toFloat(), juce::RectanglePlacement::centred);
+}
+
+void MiniRiserNativeEditor::resized()
+{
+    // The knob tracks the background's scale, so the cap lines up with the painted bezel
+    const auto scale = static_cast<float>(getWidth()) / static_cast<float>(artwork->background.getWidth());
+    impactKnob.setBounds(artwork->knobArea.toFloat().transformedBy(juce::AffineTransform::scale(scale)).toNearestInt());
+}
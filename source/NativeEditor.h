@@ -0,0 +1,51 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+// Lightweight alternative to the WebView editor: the same background and knob artwork drawn
+// with juce::Graphics. The knob is a filmstrip of pre-rotated frames built once per process
+// and shared by every instance, so an open editor costs a couple of image blits per change
+// and no browser process. Selected with MINIRISER_NATIVE_EDITOR or at runtime by setting
+// the MINIRISER_EDITOR environment variable to "native" or "web".
+class MiniRiserNativeEditor : public juce::AudioProcessorEditor
+{
+public:
+    explicit MiniRiserNativeEditor (MiniRiserAudioProcessor&);
+    ~MiniRiserNativeEditor() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    // Background and knob filmstrip at the artwork's native resolution
+    struct Artwork {
+        Artwork();
+
+        static constexpr int numKnobFrames = 128;
+        static constexpr float maxKnobRotationDegrees = 300.0f;
+
+        juce::Image background, knobFrames;
+        juce::Rectangle<int> knobArea;          // Where the knob sits in the background, in artwork pixels
+    };
+
+private:
+    class KnobLookAndFeel : public juce::LookAndFeel_V4
+    {
+    public:
+        explicit KnobLookAndFeel (const Artwork& artworkToUse) : artwork (artworkToUse) {}
+
+        void drawRotarySlider (juce::Graphics&, int x, int y, int width, int height, float sliderPosProportional,
+                               float rotaryStartAngle, float rotaryEndAngle, juce::Slider&) override;
+
+    private:
+        const Artwork& artwork;
+    };
+
+    juce::SharedResourcePointer<Artwork> artwork;
+    KnobLookAndFeel knobLookAndFeel { *artwork };
+
+    juce::Slider impactKnob;
+    juce::SliderParameterAttachment impactAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MiniRiserNativeEditor)
+};
@@ -15,17 +15,29 @@ MiniRiserAudioProcessorEditor::MiniRiserAudioProcessorEditor (MiniRiserAudioProc
               .withResourceProvider([this](const juce::String& url) { return getResource(url); })
               .withNativeIntegrationEnabled()
               .withOptionsFrom(impactRelay)
+              // The overlay turns measuring on only while it is shown, since measuring splits
+              // the processor's fused pass
+              .withNativeFunction("setTelemetryEnabled", [this](const juce::Array<juce::var>& args,
+                                                                   juce::WebBrowserComponent::NativeFunctionCompletion completion) {
+                  audioProcessor.getTelemetry().setEnabled(args.size() > 0 && static_cast<bool>(args[0]));
+                  completion({});
+              })
       }
 {
     addAndMakeVisible (webView);
     webView.goToURL(webView.getResourceProviderRoot());
     setSize (310, 310);
+    
+    telemetryFrames.resize(1024);
+    startTimerHz(telemetryRateHz);
     //setResizable(true, true);
     //setResizeLimits(600, 400, 1200, 800);
 }
 
 MiniRiserAudioProcessorEditor::~MiniRiserAudioProcessorEditor()
 {
+    stopTimer();
+    audioProcessor.getTelemetry().setEnabled(false);
 }
 
 void MiniRiserAudioProcessorEditor::paint (juce::Graphics& g)
@@ -80,70 +92,52 @@ void MiniRiserAudioProcessorEditor::mouseUp(const juce::MouseEvent& e)
 
 void MiniRiserAudioProcessorEditor::timerCallback()
 {
-    // Timer callback for potential future use
-}
+    auto& telemetry = audioProcessor.getTelemetry();
+    const int numFrames = telemetry.pop(telemetryFrames.data(), static_cast<int>(telemetryFrames.size()));
+    if (numFrames == 0)
+        return;
 
-juce::String MiniRiserAudioProcessorEditor::getMimeForExtension(const juce::String& extension)
-{
-    static juce::HashMap<juce::String, juce::String> mimeMap;
-    static bool initialized = false;
-    
-    if (!initialized) {
-        mimeMap.set("html", "text/html");
-        mimeMap.set("css", "text/css");
-        mimeMap.set("js", "application/javascript");
-        mimeMap.set("png", "image/png");
-        mimeMap.set("jpg", "image/jpeg");
-        mimeMap.set("jpeg", "image/jpeg");
-        mimeMap.set("gif", "image/gif");
-        mimeMap.set("svg", "image/svg+xml");
-        mimeMap.set("ico", "image/x-icon");
-        mimeMap.set("woff", "font/woff");
-        mimeMap.set("woff2", "font/woff2");
-        mimeMap.set("ttf", "font/ttf");
-        mimeMap.set("otf", "font/otf");
-        initialized = true;
+    juce::Array<juce::var> frames;
+    frames.ensureStorageAllocated(numFrames);
+
+    for (int i = 0; i < numFrames; ++i) {
+        const auto& frame = telemetryFrames[static_cast<size_t>(i)];
+
+        auto* stages = new juce::DynamicObject();
+        for (int stage = 0; stage < riser::TelemetryFrame::numStages; ++stage)
+            stages->setProperty(riser::TelemetryFrame::getStageName(stage), frame.stageMicros[static_cast<size_t>(stage)]);
+
+        auto* object = new juce::DynamicObject();
+        object->setProperty("block", static_cast<juce::int64>(frame.blockIndex));
+        object->setProperty("samples", frame.numSamples);
+        object->setProperty("peak", frame.peak);
+        object->setProperty("rms", frame.rms);
+        object->setProperty("reductionDb", frame.reductionDb);
+        object->setProperty("stageMicros", juce::var(stages));
+        object->setProperty("blockMicros", frame.blockMicros);
+        object->setProperty("budgetPercent", frame.budgetPercent);
+        object->setProperty("overruns", static_cast<juce::int64>(frame.overruns));
+        object->setProperty("dropped", static_cast<juce::int64>(frame.droppedFrames));
+        frames.add(juce::var(object));
     }
-    
-    return mimeMap[extension.toLowerCase()];
+
+    auto* batch = new juce::DynamicObject();
+    batch->setProperty("instance", telemetry.getInstanceId());
+    batch->setProperty("sampleRate", audioProcessor.getSampleRate());
+    batch->setProperty("frames", frames);
+    webView.emitEventIfBrowserIsVisible("telemetry", juce::var(batch));
 }
 
+// Assets come from the shared table; the copy into Resource is the only per-request work
 std::optional<juce::WebBrowserComponent::Resource> 
 MiniRiserAudioProcessorEditor::getResource(const juce::String& url)
 {
-    // Debug logging to file
-    juce::File debugFile = juce::File::getSpecialLocation(juce::File::userDesktopDirectory)
-                                   .getChildFile("PluginResourceDebug.txt");
-    juce::String debugMessage = juce::Time::getCurrentTime().toString(true, true) + 
-                               ": Requested URL: " + url + "\n";
-    debugFile.appendText(debugMessage);
-    
-    const auto resourceToRetrieve = url == "/" ? "index.html" : url.fromLastOccurrenceOf("/", false, false);
-    
-    // Convert resourceToRetrieve to a valid C++ identifier (exactly like JUCE does)
-    juce::String resourceName = resourceToRetrieve.replaceCharacter('/', '_')
-                                                  .replaceCharacter('.', '_')
-                                                  .removeCharacters("-")       // Remove dashes (don't replace with underscores)
-                                                  .removeCharacters(" ");      // Remove spaces
-    
-    debugFile.appendText("  Resource to retrieve: " + resourceToRetrieve + "\n");
-    debugFile.appendText("  Converted resource name: " + resourceName + "\n");
-    
-    // Get the resource data and size
-    int resourceSize = 0;
-    const char* resourceData = BinaryData::getNamedResource(resourceName.toRawUTF8(), resourceSize);
+    const auto* asset = resources->find(url);
+    if (asset == nullptr)
+        return std::nullopt;
 
-    if (resourceData != nullptr && resourceSize > 0)
-    {
-        debugFile.appendText("  Found resource, size: " + juce::String(resourceSize) + "\n");
-        const auto extension = resourceToRetrieve.fromLastOccurrenceOf(".", false, false);
-        return juce::WebBrowserComponent::Resource{
-            std::vector<std::byte>(reinterpret_cast<const std::byte*>(resourceData), 
-                                 reinterpret_cast<const std::byte*>(resourceData) + resourceSize), 
-            getMimeForExtension(extension)
-        };
-    }
-
-    debugFile.appendText("  Resource NOT FOUND!\n");
-    return std::nullopt;
-}
\ No newline at end of file
+    return juce::WebBrowserComponent::Resource{
+        std::vector<std::byte>(asset->data, asset->data + asset->size),
+        asset->mimeType
+    };
+}
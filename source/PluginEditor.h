@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "ResourceTable.h"
 
 class MiniRiserAudioProcessorEditor : public juce::AudioProcessorEditor,
                                         private juce::Timer
@@ -20,15 +21,21 @@ public:
 private:
     void timerCallback() override;
     std::optional<juce::WebBrowserComponent::Resource> getResource(const juce::String& url);
-    juce::String getMimeForExtension(const juce::String& extension);
 
     MiniRiserAudioProcessor& audioProcessor;
     
     juce::WebSliderRelay impactRelay;
     juce::WebSliderParameterAttachment impactAttachment;
     
+    // Declared before the WebView so it outlives any request still being answered
+    juce::SharedResourcePointer<riser::ResourceTable> resources;
+    
     juce::WebBrowserComponent webView;
     
+    // Telemetry is drained at a fixed UI rate and sent to the page as one event per tick
+    static constexpr int telemetryRateHz = 30;
+    std::vector<riser::TelemetryFrame> telemetryFrames;
+    
     // Mouse tracking for sas1-plugin style event forwarding
     juce::Point<int> lastDragPosition;
     bool isDragging = false;
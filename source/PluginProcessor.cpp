@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "NativeEditor.h"
 
 MiniRiserAudioProcessor::MiniRiserAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -12,17 +13,34 @@ MiniRiserAudioProcessor::MiniRiserAudioProcessor()
                      #endif
                        ),
 #endif
-      state{*this, nullptr, "PARAMETERS", createParameterLayout(parameters)}
+      state{*this, nullptr, "PARAMETERS", createParameterLayout(parameters)},
+      presets{state}
 {
-    state.addParameterListener("impact", this);
     impactSmoothed.setCurrentAndTargetValue(0.0f);
     
     delayParams.wetLevel.setCurrentAndTargetValue(0.0f);
     delayParams.feedback.setCurrentAndTargetValue(0.0f);
+
+    lastParameterEvent.assign(static_cast<size_t>(getParameters().size()), -1);
+    parameterEventsApplied = std::vector<std::atomic<bool>>(static_cast<size_t>(getParameters().size()));
+    prepareParameterEvents(1024);
+
+   #if MINIRISER_CLAP
+    // The wrapper identifies JUCE parameters to the host by the hash of their parameter ID
+    for (auto* parameter : getParameters())
+        if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+            clapParameters.emplace_back(static_cast<clap_id>(withId->paramID.hashCode()), parameter);
+
+    std::sort(clapParameters.begin(), clapParameters.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+   #endif
+
+    startTimerHz(latencyPollHz);
 }
 
 MiniRiserAudioProcessor::~MiniRiserAudioProcessor()
 {
+    stopTimer();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout 
@@ -38,17 +56,98 @@ MiniRiserAudioProcessor::createParameterLayout(Parameters& parameters)
     parameters.impact = impactParam.get();
     layout.add(std::move(impactParam));
     
+    // "Bits + Rate" adds sample-and-hold decimation that deepens with Impact
+    auto crushModeParam = std::make_unique<juce::AudioParameterChoice>(
+        "crushMode", "Crush Mode",
+        juce::StringArray { "Bits", "Bits + Rate" },
+        0
+    );
+    parameters.crushMode = crushModeParam.get();
+    layout.add(std::move(crushModeParam));
+    
+    auto crushAntialiasParam = std::make_unique<juce::AudioParameterBool>(
+        "crushAntialias", "Crush Anti-alias",
+        true
+    );
+    parameters.crushAntialias = crushAntialiasParam.get();
+    layout.add(std::move(crushAntialiasParam));
+    
+    // Order matches riser::Lfo::Shape
+    auto panShapeParam = std::make_unique<juce::AudioParameterChoice>(
+        "panShape", "Pan Shape",
+        juce::StringArray { "Sine", "Triangle", "Saw", "Square" },
+        0
+    );
+    parameters.panShape = panShapeParam.get();
+    layout.add(std::move(panShapeParam));
+    
+    // "Free" runs the auto-panner at 2 Hz; the rest lock it to the host tempo
+    auto panSyncParam = std::make_unique<juce::AudioParameterChoice>(
+        "panSync", "Pan Sync",
+        juce::StringArray { "Free", "1 Bar", "1/2", "1/4", "1/8", "1/16" },
+        0
+    );
+    parameters.panSync = panSyncParam.get();
+    layout.add(std::move(panSyncParam));
+    
+    // "Free" keeps the fixed 125 ms delay; the rest follow the host tempo
+    auto delaySyncParam = std::make_unique<juce::AudioParameterChoice>(
+        "delaySync", "Delay Sync",
+        juce::StringArray { "Free", "1/4", "1/8 Dotted", "1/8", "1/16" },
+        0
+    );
+    parameters.delaySync = delaySyncParam.get();
+    layout.add(std::move(delaySyncParam));
+    
+    // Ramps Impact up to the knob's value over this many bars, locked to the host position
+    auto riseLengthParam = std::make_unique<juce::AudioParameterChoice>(
+        "riseLength", "Rise Length",
+        juce::StringArray { "Off", "1 Bar", "2 Bars", "4 Bars", "8 Bars", "16 Bars" },
+        0
+    );
+    parameters.riseLength = riseLengthParam.get();
+    layout.add(std::move(riseLengthParam));
+    
+    // Order matches riser::RiserEnvelope::Curve
+    auto riseCurveParam = std::make_unique<juce::AudioParameterChoice>(
+        "riseCurve", "Rise Curve",
+        juce::StringArray { "Linear", "Exponential", "Logarithmic", "S-Curve" },
+        0
+    );
+    parameters.riseCurve = riseCurveParam.get();
+    layout.add(std::move(riseCurveParam));
+    
+    // Quality settings rather than performance controls, so hosts shouldn't automate them
+    auto oversamplingParam = std::make_unique<juce::AudioParameterChoice>(
+        "oversampling", "Oversampling",
+        juce::StringArray { "Off", "2x", "4x", "8x" },
+        0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    );
+    parameters.oversampling = oversamplingParam.get();
+    layout.add(std::move(oversamplingParam));
+    
+    auto oversamplingModeParam = std::make_unique<juce::AudioParameterChoice>(
+        "oversamplingMode", "Oversampling Mode",
+        juce::StringArray { "Minimum Phase", "Linear Phase" },
+        0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    );
+    parameters.oversamplingMode = oversamplingModeParam.get();
+    layout.add(std::move(oversamplingModeParam));
+    
+    // Delays the shaped signal by 2 ms so the shaper reacts before an onset is heard
+    auto transientLookaheadParam = std::make_unique<juce::AudioParameterBool>(
+        "transientLookahead", "Transient Lookahead",
+        false,
+        juce::AudioParameterBoolAttributes().withAutomatable(false)
+    );
+    parameters.transientLookahead = transientLookaheadParam.get();
+    layout.add(std::move(transientLookaheadParam));
+    
     return layout;
 }
 
-void MiniRiserAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
-{
-    if (parameterID == "impact") {
-        impactSmoothed.setTargetValue(newValue);
-        updateEffectParameters(newValue);
-    }
-}
-
 const juce::String MiniRiserAudioProcessor::getName() const
 {
     return JucePlugin_Name;
@@ -83,72 +182,137 @@ bool MiniRiserAudioProcessor::isMidiEffect() const
 
 double MiniRiserAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // Echoes fall by the feedback on every repeat; count repeats down to -60 dB, then the last
+    // echo still has to decay through the reverb. Synced delays may grow with the host tempo.
+    const double delaySeconds = parameters.delaySync->getIndex() == 0 ? freeDelaySeconds : maxDelaySeconds;
+    const double feedback = juce::jlimit(0.01, 0.95, static_cast<double>(impactMapping.getMaximum(riser::ImpactMapping::delayFeedback)));
+    const double repeats = std::log(0.001) / std::log(feedback);
+    return repeats * delaySeconds + reverbDecaySeconds;
 }
 
 int MiniRiserAudioProcessor::getNumPrograms()
 {
-    return 1;
+    return presets.getNumPresets();
 }
 
 int MiniRiserAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
+// Selecting the current program again recalls it, discarding any edits made since
 void MiniRiserAudioProcessor::setCurrentProgram (int index)
 {
+    if (! juce::isPositiveAndBelow(index, presets.getNumPresets()))
+        return;
+
+    currentProgram = index;
+    presets.apply(index);
 }
 
 const juce::String MiniRiserAudioProcessor::getProgramName (int index)
 {
-    return {};
+    if (! juce::isPositiveAndBelow(index, presets.getNumPresets()))
+        return {};
+
+    return presets.getName(index);
 }
 
 void MiniRiserAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    // Factory programs are read-only
+    juce::ignoreUnused (index, newName);
 }
 
 void MiniRiserAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = static_cast<float>(sampleRate);
+    prepareParameterEvents(samplesPerBlock);
+    preparedChannels = juce::jmax(1, getTotalNumInputChannels(), getTotalNumOutputChannels());
+
+    const auto channelSet = getChannelLayoutOfBus(false, 0);
+    effectChannels.clear();
+    lfeChannels.clear();
+    for (int channel = 0; channel < preparedChannels; ++channel) {
+        if (channelSet.getTypeOfChannel(channel) == juce::AudioChannelSet::LFE)
+            lfeChannels.push_back(channel);
+        else
+            effectChannels.push_back(channel);
+    }
     
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = 2;
-    
-    leftChain.processorChain.prepare(spec);
-    rightChain.processorChain.prepare(spec);
-    
-    auto& leftHighPass = leftChain.processorChain.template get<EffectChain::highPassIndex>();
-    auto& rightHighPass = rightChain.processorChain.template get<EffectChain::highPassIndex>();
-    leftHighPass.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 20.0f);
-    rightHighPass.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 20.0f);
-    
-    auto& leftReverb = leftChain.processorChain.template get<EffectChain::reverbIndex>();
-    auto& rightReverb = rightChain.processorChain.template get<EffectChain::reverbIndex>();
-    juce::dsp::Reverb::Parameters reverbParams;
-    reverbParams.roomSize = 0.8f;
-    reverbParams.damping = 0.3f;
-    reverbParams.wetLevel = 0.0f;
-    reverbParams.dryLevel = 1.0f;
-    reverbParams.width = 1.0f;
-    leftReverb.setParameters(reverbParams);
-    rightReverb.setParameters(reverbParams);
-    
-    lfoForPanning.initialise([](float x) { return std::sin(x); });
-    lfoForPanning.setFrequency(2.0f);
-    lfoForPanning.prepare(spec);
+    // Only the chain for the precision the host asked for holds any memory
+    if (isUsingDoublePrecision())
+        prepareChain<double>(sampleRate, samplesPerBlock);
+    else
+        prepareChain<float>(sampleRate, samplesPerBlock);
+    
+    modulation.getLfo(panLfoIndex).setFrequency(2.0);
+    modulation.prepare(sampleRate);
+    riserEnvelope.prepare(sampleRate);
+    
+    channelPanSides.resize(effectChannels.size());
+    for (size_t i = 0; i < effectChannels.size(); ++i)
+        channelPanSides[i] = getPanSide(channelSet.getTypeOfChannel(effectChannels[i]));
     
     impactSmoothed.reset(sampleRate, 0.05);
+    sendLevel.reset(sampleRate, 0.05);
     delayParams.wetLevel.reset(sampleRate, 0.05);
     delayParams.feedback.reset(sampleRate, 0.05);
+    delayParams.timeInSamples.reset(sampleRate, 0.05);
+    
+    updateDelayTime({});
+    delayParams.timeInSamples.setCurrentAndTargetValue(delayParams.timeInSamples.getTargetValue());
+
+    impactSmoothed.setCurrentAndTargetValue(parameters.impact->get());
+    crushRateReduction = parameters.crushMode->getIndex() == 1;
+    lastControlImpact = -1.0f;
+    if (isUsingDoublePrecision())
+        updateEffectParameters<double>(impactSmoothed.getCurrentValue());
+    else
+        updateEffectParameters<float>(impactSmoothed.getCurrentValue());
+    delayParams.wetLevel.setCurrentAndTargetValue(delayParams.wetLevel.getTargetValue());
+    delayParams.feedback.setCurrentAndTargetValue(delayParams.feedback.getTargetValue());
+    lastMakeupGain = getMakeupGain(impactSmoothed.getCurrentValue() / 100.0f);
+    
+    const bool active = impactSmoothed.getCurrentValue() / 100.0f > 0.001f;
+    processingState = active ? ProcessingState::active : ProcessingState::idle;
+    sendLevel.setCurrentAndTargetValue(active ? 1.0f : 0.0f);
+    heldImpact = 0.0f;
+    silentSamples = 0;
+}
+
+template <typename SampleType>
+void MiniRiserAudioProcessor::prepareChain(double sampleRate, int samplesPerBlock)
+{
+    auto& chain = getChain<SampleType>();
+    
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.numChannels = static_cast<juce::uint32>(effectChannels.size());
+    
+    // The crusher may run on a control block oversampled by up to 8x
+    spec.maximumBlockSize = static_cast<juce::uint32>(juce::jmax(samplesPerBlock, controlRateSamples * 8));
+    
+    // Allocated once here; updateEffectParameters only overwrites the values in place
+    chain.highPassCoefficients = juce::dsp::IIR::Coefficients<SampleType>::makeHighPass(sampleRate, SampleType(20));
+    chain.engine.prepare(spec, chain.highPassCoefficients, static_cast<int>(std::ceil(sampleRate * maxDelaySeconds)),
+                         getLookaheadSamples(parameters.transientLookahead->get()));
+    chain.engineParameters.antialias = parameters.crushAntialias->get();
     
-    delayParams.delayTimeInSamples = static_cast<float>(sampleRate * 0.125);
-    delayParams.delayBuffer.setSize(2, static_cast<int>(sampleRate * 2.0));
-    delayParams.delayBuffer.clear();
-    delayParams.writeIndex = 0;
+    chain.reverbParameters = {};
+    chain.reverbParameters.decaySeconds = reverbDecaySeconds;
+    chain.reverb.prepare(sampleRate, static_cast<int>(effectChannels.size()));
+    
+    chain.delayLevels.setSize(2, samplesPerBlock);
+    chain.dryBuffer.setSize(preparedChannels, controlRateSamples);
+    chain.panGains.assign(effectChannels.size(), SampleType(1));
+    chain.targetPanGains.assign(effectChannels.size(), SampleType(1));
+    chain.busChannels.assign(effectChannels.size(), nullptr);
+    prepareLatency<SampleType>();
+    
+    // Nothing can still be in flight once the output has been silent for longer than the
+    // longest delay plus the longest reverb line
+    silenceHoldSamples = static_cast<int>(std::ceil(sampleRate * maxDelaySeconds) + static_cast<double>(chain.reverb.getLongestLineSamples()));
 }
 
 void MiniRiserAudioProcessor::releaseResources()
@@ -162,8 +326,8 @@ bool MiniRiserAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
     juce::ignoreUnused (layouts);
     return true;
   #else
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    const auto& outputSet = layouts.getMainOutputChannelSet();
+    if (outputSet.isDisabled() || outputSet.size() > maxChannels)
         return false;
 
    #if ! JucePlugin_IsSynth
@@ -176,154 +340,607 @@ bool MiniRiserAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
 }
 #endif
 
+// Called from the audio thread at control rate; must not allocate or lock
+template <typename SampleType>
 void MiniRiserAudioProcessor::updateEffectParameters(float impactValue)
 {
-    float normalizedImpact = impactValue / 100.0f;
-    
-    auto& leftHighPass = leftChain.processorChain.template get<EffectChain::highPassIndex>();
-    auto& rightHighPass = rightChain.processorChain.template get<EffectChain::highPassIndex>();
-    float cutoffFreq = 20.0f + (normalizedImpact * (1500.0f - 20.0f));
-    leftHighPass.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(currentSampleRate, cutoffFreq);
-    rightHighPass.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(currentSampleRate, cutoffFreq);
-    
-    auto& leftTransientShaper = leftChain.processorChain.template get<EffectChain::transientShaperIndex>();
-    auto& rightTransientShaper = rightChain.processorChain.template get<EffectChain::transientShaperIndex>();
-    float transientGain = 1.0f - (normalizedImpact * 0.5f);
-    leftTransientShaper.setGainLinear(transientGain);
-    rightTransientShaper.setGainLinear(transientGain);
+    if (impactValue == lastControlImpact)
+        return;
+
+    using Target = riser::ImpactMapping::Target;
+    auto& chain = getChain<SampleType>();
+    lastControlImpact = impactValue;
+    const float normalizedImpact = impactValue / 100.0f;
+    const auto map = [this, normalizedImpact](Target target) { return impactMapping.evaluate(target, normalizedImpact); };
     
-    bitCrusherParams.bitDepth = 24.0f - (normalizedImpact * 18.0f);
-    if (bitCrusherParams.bitDepth < 1.0f) bitCrusherParams.bitDepth = 1.0f;
-    bitCrusherParams.quantizationStep = 2.0f / std::pow(2.0f, bitCrusherParams.bitDepth);
+    const float cutoffFreq = juce::jmin(map(Target::highPassCutoff), currentSampleRate * 0.45f);
+    *chain.highPassCoefficients = juce::dsp::IIR::ArrayCoefficients<SampleType>::makeHighPass(currentSampleRate, static_cast<SampleType>(cutoffFreq));
     
-    auto& leftPanner = leftChain.processorChain.template get<EffectChain::autoPannerIndex>();
-    auto& rightPanner = rightChain.processorChain.template get<EffectChain::autoPannerIndex>();
-    float panAmount = normalizedImpact;
-    leftPanner.setPan(-panAmount);
-    rightPanner.setPan(panAmount);
+    auto& engineParameters = chain.engineParameters;
+    engineParameters.transientAttack = static_cast<SampleType>(map(Target::transientAttack));
+    engineParameters.transientSustain = static_cast<SampleType>(map(Target::transientSustain));
+    engineParameters.bitDepth = static_cast<SampleType>(map(Target::bitDepth));
+    engineParameters.downsampleFactor = static_cast<SampleType>(crushRateReduction ? map(Target::downsampleFactor) : 1.0f);
     
-    auto& leftReverb = leftChain.processorChain.template get<EffectChain::reverbIndex>();
-    auto& rightReverb = rightChain.processorChain.template get<EffectChain::reverbIndex>();
-    juce::dsp::Reverb::Parameters reverbParams;
-    reverbParams.roomSize = 0.8f;
-    reverbParams.damping = 0.3f;
-    float reverbWetLevel = normalizedImpact * 0.5f;
-    reverbParams.wetLevel = reverbWetLevel;
-    reverbParams.dryLevel = 1.0f - reverbWetLevel;  // Proper wet/dry mix
-    reverbParams.width = 1.0f;
-    leftReverb.setParameters(reverbParams);
-    rightReverb.setParameters(reverbParams);
+    const float reverbWetLevel = map(Target::reverbWet);
+    chain.reverbParameters.wetLevel = static_cast<SampleType>(reverbWetLevel * reverbWetScale);
+    chain.reverbParameters.dryLevel = static_cast<SampleType>((1.0f - reverbWetLevel) * reverbDryScale);  // Proper wet/dry mix
+    chain.reverb.setParameters(chain.reverbParameters);
     
-    delayParams.wetLevel.setTargetValue(normalizedImpact * 0.4f);
-    delayParams.feedback.setTargetValue(normalizedImpact * 0.75f);
+    delayParams.wetLevel.setTargetValue(map(Target::delayWet));
+    delayParams.feedback.setTargetValue(map(Target::delayFeedback));
 }
 
-float MiniRiserAudioProcessor::applyBitCrushing(float sample, float bitDepth)
+void MiniRiserAudioProcessor::updateModulation(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position)
 {
-    if (bitDepth >= 24.0f) return sample;
-    
-    float quantizationStep = bitCrusherParams.quantizationStep;
-    return std::round(sample / quantizationStep) * quantizationStep;
+    static constexpr double panSyncBeats[] = { 0.0, 4.0, 2.0, 1.0, 0.5, 0.25 };
+
+    auto& panLfo = modulation.getLfo(panLfoIndex);
+    panLfo.setShape(static_cast<riser::Lfo::Shape>(parameters.panShape->getIndex()));
+
+    const auto syncIndex = juce::jlimit(0, 5, parameters.panSync->getIndex());
+    if (syncIndex == 0)
+        panLfo.setFrequency(2.0);
+    else
+        panLfo.setTempoSync(panSyncBeats[syncIndex]);
+
+    if (position.hasValue())
+        modulation.setHostPosition(position->getBpm(), position->getPpqPosition(), position->getIsPlaying());
+}
+
+void MiniRiserAudioProcessor::updateDelayTime(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position)
+{
+    static constexpr double delaySyncBeats[] = { 0.0, 1.0, 0.75, 0.5, 0.25 };
+
+    if (position.hasValue())
+        if (const auto bpm = position->getBpm(); bpm.hasValue() && *bpm > 0.0)
+            hostTempo = *bpm;
+
+    const auto syncIndex = juce::jlimit(0, 4, parameters.delaySync->getIndex());
+    const double delaySeconds = syncIndex == 0 ? freeDelaySeconds : delaySyncBeats[syncIndex] * 60.0 / hostTempo;
+    delayParams.timeInSamples.setTargetValue(static_cast<float>(juce::jmin(delaySeconds, maxDelaySeconds) * currentSampleRate));
+}
+
+void MiniRiserAudioProcessor::updateRiserEnvelope(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, int numSamples)
+{
+    static constexpr double riseLengthBars[] = { 0.0, 1.0, 2.0, 4.0, 8.0, 16.0 };
+
+    riserEnvelope.setLength(riseLengthBars[juce::jlimit(0, 5, parameters.riseLength->getIndex())]);
+    riserEnvelope.setCurve(static_cast<riser::RiserEnvelope::Curve>(parameters.riseCurve->getIndex()));
+    riserEnvelope.beginBlock(position, numSamples);
+}
+
+float MiniRiserAudioProcessor::getPanSide(juce::AudioChannelSet::ChannelType type)
+{
+    using Type = juce::AudioChannelSet::ChannelType;
+
+    // Listed rather than switched on, since ChannelType has far more values than sides
+    static constexpr Type leftTypes[] { Type::left, Type::leftCentre, Type::leftSurround, Type::leftSurroundSide,
+                                        Type::leftSurroundRear, Type::wideLeft, Type::topFrontLeft,
+                                        Type::topSideLeft, Type::topRearLeft };
+    static constexpr Type rightTypes[] { Type::right, Type::rightCentre, Type::rightSurround, Type::rightSurroundSide,
+                                         Type::rightSurroundRear, Type::wideRight, Type::topFrontRight,
+                                         Type::topSideRight, Type::topRearRight };
+
+    if (std::find(std::begin(leftTypes), std::end(leftTypes), type) != std::end(leftTypes))
+        return -1.0f;
+
+    if (std::find(std::begin(rightTypes), std::end(rightTypes), type) != std::end(rightTypes))
+        return 1.0f;
+
+    return 0.0f;
+}
+
+float MiniRiserAudioProcessor::getMakeupGain(float normalizedImpact) const noexcept
+{
+    return impactMapping.evaluate(riser::ImpactMapping::makeupGain, normalizedImpact);
 }
 
 void MiniRiserAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    juce::ignoreUnused (midiMessages);
+    const riser::RealtimeCheck::Scope realtimeScope;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    process(buffer);
+    applyParameterEvents(std::numeric_limits<int>::max());
+    publishTelemetry(buffer, startTicks);
+}
+
+void MiniRiserAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused (midiMessages);
+    const riser::RealtimeCheck::Scope realtimeScope;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    process(buffer);
+    applyParameterEvents(std::numeric_limits<int>::max());
+    publishTelemetry(buffer, startTicks);
+}
+
+#if MINIRISER_CLAP
+bool MiniRiserAudioProcessor::supportsDirectEvent (uint16_t spaceId, uint16_t type)
+{
+    return spaceId == CLAP_CORE_EVENT_SPACE_ID && type == CLAP_EVENT_PARAM_VALUE;
+}
+
+// Called on the audio thread for each event of the coming block, before processBlock
+void MiniRiserAudioProcessor::handleDirectEvent (const clap_event_header_t* event, int sampleOffset)
+{
+    const auto* valueEvent = reinterpret_cast<const clap_event_param_value_t*>(event);
+    const auto found = std::lower_bound(clapParameters.begin(), clapParameters.end(), valueEvent->param_id,
+                                        [](const auto& entry, clap_id id) { return entry.first < id; });
+
+    if (found != clapParameters.end() && found->first == valueEvent->param_id)
+        queueParameterEvent(found->second, static_cast<float>(valueEvent->value), sampleOffset);
+}
+#endif
+
+// Message thread, with processing stopped: room for one event per parameter and control block
+void MiniRiserAudioProcessor::prepareParameterEvents(int maximumBlockSize)
+{
+    maxEventControlBlocks = juce::jmax(1, (maximumBlockSize + controlRateSamples - 1) / controlRateSamples);
+    parameterEvents.resize(lastParameterEvent.size() * static_cast<size_t>(maxEventControlBlocks));
+    numParameterEvents = nextParameterEvent = 0;
+    std::fill(lastParameterEvent.begin(), lastParameterEvent.end(), -1);
+}
+
+// Events arrive in time order. Anything past the largest prepared block counts as its last
+// control block, so the queue can't overflow even if the host sends a longer one.
+// Coalescing uses the nominal grid of controlRateSamples, which is approximate: process() also
+// cuts control blocks where a rise cycle starts, and those cuts aren't known yet when events
+// are queued. A value coalesced across such a cut keeps the earlier event's offset, so it can
+// take effect up to one control block early.
+void MiniRiserAudioProcessor::queueParameterEvent(juce::AudioProcessorParameter* parameter, float value, int sampleOffset) noexcept
+{
+    const auto controlBlockOf = [this](int offset) { return juce::jmin(offset / controlRateSamples, maxEventControlBlocks - 1); };
+    auto& last = lastParameterEvent[static_cast<size_t>(parameter->getParameterIndex())];
+
+    if (last >= 0 && controlBlockOf(parameterEvents[static_cast<size_t>(last)].sampleOffset) == controlBlockOf(sampleOffset)) {
+        parameterEvents[static_cast<size_t>(last)].value = value;
+        return;
+    }
+
+    if (numParameterEvents == static_cast<int>(parameterEvents.size())) {
+        jassertfalse;
+        return;
+    }
+
+    last = numParameterEvents;
+    parameterEvents[static_cast<size_t>(numParameterEvents++)] = { parameter, value, sampleOffset };
+}
+
+// Applies queued events due before endSample and reports whether there were any. Setting the
+// value is lock-free; the listener callbacks, which lock, wait for the message thread.
+bool MiniRiserAudioProcessor::applyParameterEvents(int endSample) noexcept
+{
+    const int firstEvent = nextParameterEvent;
+
+    for (; nextParameterEvent < numParameterEvents; ++nextParameterEvent) {
+        const auto& event = parameterEvents[static_cast<size_t>(nextParameterEvent)];
+        if (event.sampleOffset >= endSample)
+            break;
+
+        event.parameter->setValue(event.value);
+        parameterEventsApplied[static_cast<size_t>(event.parameter->getParameterIndex())].store(true, std::memory_order_release);
+    }
+
+    const bool applied = nextParameterEvent != firstEvent;
+    if (nextParameterEvent == numParameterEvents) {
+        for (int i = 0; i < numParameterEvents; ++i)
+            lastParameterEvent[static_cast<size_t>(parameterEvents[static_cast<size_t>(i)].parameter->getParameterIndex())] = -1;
+        numParameterEvents = nextParameterEvent = 0;
+    }
+
+    return applied;
+}
+
+void MiniRiserAudioProcessor::notifyParameterEventListeners()
+{
+    const auto& allParameters = getParameters();
+
+    for (size_t i = 0; i < parameterEventsApplied.size(); ++i)
+        if (parameterEventsApplied[i].exchange(false, std::memory_order_acquire))
+            allParameters[static_cast<int>(i)]->sendValueChangedMessageToListeners(allParameters[static_cast<int>(i)]->getValue());
+}
+
+template <typename SampleType>
+void MiniRiserAudioProcessor::process (juce::AudioBuffer<SampleType>& buffer)
+{
+    jassert (isUsingDoublePrecision() == (std::is_same_v<SampleType, double>));
+    
     juce::ScopedNoDenormals noDenormals;
+    measuringStages = telemetry.isEnabled();
+    stageTicks.fill(0);
+    shaperInputEnergy = crusherOutputEnergy = 0.0;
+    auto& chain = getChain<SampleType>();
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
-        impactSmoothed.getNextValue();
-        delayParams.wetLevel.getNextValue();
-        delayParams.feedback.getNextValue();
+    // Lock-free handoff: the parameter value is an atomic written by the host/UI thread
+    applyParameterEvents(controlRateSamples);
+    impactSmoothed.setTargetValue(parameters.impact->get());
+    chain.engineParameters.antialias = parameters.crushAntialias->get();
+
+    // Edited mapping curves are picked up here and force the effect parameters to be recomputed
+    const bool rateReduction = parameters.crushMode->getIndex() == 1;
+    if (impactMapping.update() || rateReduction != crushRateReduction) {
+        crushRateReduction = rateReduction;
+        lastControlImpact = -1.0f;
     }
 
-    float currentImpact = impactSmoothed.getCurrentValue() / 100.0f;
-    
-    // Complete bypass when Impact = 0
-    if (currentImpact <= 0.001f) {
-        // Audio passes through completely unprocessed
+    juce::Optional<juce::AudioPlayHead::PositionInfo> position;
+    if (auto* playHead = getPlayHead())
+        position = playHead->getPosition();
+
+    updateModulation(position);
+    updateDelayTime(position);
+    updateRiserEnvelope(position, buffer.getNumSamples());
+
+    const bool latencyChanged = parameters.oversampling->getIndex() != oversamplingIndex
+                             || parameters.oversamplingMode->getIndex() != oversamplingModeIndex
+                             || parameters.transientLookahead->get() != lookaheadEnabled;
+    if (latencyChanged)
+        latencyChangePending.store(true, std::memory_order_release);
+
+    updateProcessingState();
+    if (processingState == ProcessingState::idle) {
+        compensateLatency(juce::dsp::AudioBlock<SampleType>(buffer));
         return;
     }
-    
-    juce::dsp::AudioBlock<float> block(buffer);
-    
-    if (buffer.getNumChannels() >= 2) {
-        auto leftBlock = block.getSingleChannelBlock(0);
-        auto rightBlock = block.getSingleChannelBlock(1);
-        
-        juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-        juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
-        
-        leftChain.processorChain.template get<EffectChain::highPassIndex>().process(leftContext);
-        rightChain.processorChain.template get<EffectChain::highPassIndex>().process(rightContext);
-        
-        leftChain.processorChain.template get<EffectChain::transientShaperIndex>().process(leftContext);
-        rightChain.processorChain.template get<EffectChain::transientShaperIndex>().process(rightContext);
-        
-        auto* leftData = buffer.getWritePointer(0);
-        auto* rightData = buffer.getWritePointer(1);
-        const int numSamples = buffer.getNumSamples();
-        const float panDepth = juce::jlimit(0.0f, 0.8f, currentImpact);
-        const bool applyAutoPan = panDepth > 0.0f;
 
-        for (int sample = 0; sample < numSamples; ++sample) {
-            leftData[sample] = applyBitCrushing(leftData[sample], bitCrusherParams.bitDepth);
-            rightData[sample] = applyBitCrushing(rightData[sample], bitCrusherParams.bitDepth);
+    const int numSamples = buffer.getNumSamples();
+    const bool inputSilent = isSilent(buffer, 0, numSamples);
+    bool outputSilent = inputSilent;
 
-            float lfoValue = lfoForPanning.processSample(0.0f);
+    // Nothing to add to silence: skip the block without touching any state
+    if (processingState == ProcessingState::active && inputSilent && silentSamples >= silenceHoldSamples
+        && ! impactSmoothed.isSmoothing() && ! sendLevel.isSmoothing())
+        return;
+
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+    auto& dryBuffer = chain.dryBuffer;
+    const int numDryChannels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+
+    for (int start = 0, numControlSamples = 0; start < numSamples; start += numControlSamples) {
+        numControlSamples = juce::jmin(controlRateSamples, numSamples - start);
+
+        const bool cycleStarts = riseCycleStarting;
+        riseCycleStarting = false;
+        if (processingState == ProcessingState::active && riserEnvelope.isActive()) {
+            const int samplesToNextCycle = riserEnvelope.getSamplesToNextCycle(start);
+            numControlSamples = juce::jmin(numControlSamples, samplesToNextCycle);
+            riseCycleStarting = samplesToNextCycle == numControlSamples;
+        }
+
+        const auto subBlock = block.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(numControlSamples));
+
+        // Parameters freeze while ringing out so the tails keep the level they were heard at
+        float impactValue = heldImpact;
+        if (start > 0 && applyParameterEvents(start + numControlSamples))
+            impactSmoothed.setTargetValue(parameters.impact->get());
 
-            if (applyAutoPan) {
-                float panAmount = lfoValue * panDepth;
+        if (processingState == ProcessingState::active) {
+            impactValue = impactSmoothed.skip(numControlSamples);
+            if (riserEnvelope.isActive())
+                impactValue *= riserEnvelope.getValueAt(start + numControlSamples - 1);
+            updateEffectParameters<SampleType>(impactValue);
 
-                // Equal-power panning keeps perceived loudness stable across the sweep
-                float panAngle = (panAmount + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
-                float leftGain = std::cos(panAngle);
-                float rightGain = std::sin(panAngle);
+            if (cycleStarts)
+                lastMakeupGain = getMakeupGain(impactValue / 100.0f);
+        }
+
+        // The effects get the input scaled by the send level and the rest passes straight
+        // through, which crossfades cleanly in and out of the bypassed state
+        const float sendStart = sendLevel.getCurrentValue();
+        const float sendEnd = sendLevel.skip(numControlSamples);
+        const bool bypassing = sendStart < 1.0f || sendEnd < 1.0f;
+
+        // The dry copy runs through the latency compensation even while fully active, so it
+        // holds the right history the moment a crossfade starts
+        if (bypassing || latencySamples > 0) {
+            for (int channel = 0; channel < numDryChannels; ++channel)
+                dryBuffer.copyFrom(channel, 0, buffer, channel, start, numControlSamples);
+
+            compensateLatency(juce::dsp::AudioBlock<SampleType>(dryBuffer).getSubsetChannelBlock(0, static_cast<size_t>(numDryChannels))
+                                                                          .getSubBlock(0, static_cast<size_t>(numControlSamples)));
+        }
+
+        if (bypassing) {
+            for (int channel = 0; channel < numDryChannels; ++channel)
+                buffer.applyGainRamp(channel, start, numControlSamples, SampleType(sendStart), SampleType(sendEnd));
+        }
 
-                leftData[sample] *= leftGain;
-                rightData[sample] *= rightGain;
+        processControlBlock(subBlock, impactValue / 100.0f);
+
+        if (bypassing) {
+            // With the send fully closed the effect output is nothing but tail
+            if (sendStart == 0.0f && sendEnd == 0.0f) {
+                if (isSilent(buffer, start, numControlSamples))
+                    silentSamples += numControlSamples;
+                else
+                    silentSamples = 0;
             }
+
+            for (int channel = 0; channel < numDryChannels; ++channel)
+                buffer.addFromWithRamp(channel, start, dryBuffer.getReadPointer(channel), numControlSamples,
+                                       SampleType(1.0f - sendStart), SampleType(1.0f - sendEnd));
+        }
+
+        // LFE channels were left out of the effects; with latency they take the delayed dry copy
+        if (latencySamples > 0) {
+            for (auto channel : lfeChannels)
+                if (channel < numDryChannels)
+                    buffer.copyFrom(channel, start, dryBuffer, channel, 0, numControlSamples);
         }
+
+        // Checked while the control block is still in cache rather than in another full pass
+        outputSilent = outputSilent && isSilent(buffer, start, numControlSamples);
+    }
+
+    if (processingState == ProcessingState::ringingOut) {
+        if (silentSamples >= silenceHoldSamples)
+            enterIdle();
+    } else if (outputSilent) {
+        silentSamples += numSamples;
+    } else {
+        silentSamples = 0;
+    }
+}
+
+template <typename Function>
+void MiniRiserAudioProcessor::timeStage(int stage, Function&& function)
+{
+    if (! measuringStages) {
+        function();
+        return;
+    }
+
+    const auto start = juce::Time::getHighResolutionTicks();
+    function();
+    stageTicks[static_cast<size_t>(stage)] += juce::Time::getHighResolutionTicks() - start;
+}
+
+template <typename SampleType>
+double MiniRiserAudioProcessor::getEnergy(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    double energy = 0.0;
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
+        const auto* samples = block.getChannelPointer(channel);
+        for (size_t i = 0; i < block.getNumSamples(); ++i)
+            energy += static_cast<double>(samples[i]) * static_cast<double>(samples[i]);
+    }
+    return energy;
+}
+
+template <typename SampleType>
+void MiniRiserAudioProcessor::publishTelemetry(const juce::AudioBuffer<SampleType>& buffer, juce::int64 startTicks)
+{
+    const auto blockSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    const int numSamples = buffer.getNumSamples();
+    const auto deadlineSeconds = numSamples / static_cast<double>(currentSampleRate);
+
+    ++blockCount;
+    if (numSamples > 0 && blockSeconds > deadlineSeconds)
+        ++overrunCount;
+
+    if (! measuringStages || numSamples == 0)
+        return;
+
+    riser::TelemetryFrame frame;
+    frame.blockIndex = blockCount;
+    frame.numSamples = numSamples;
+
+    double sumOfSquares = 0.0;
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+        const auto rms = static_cast<double>(buffer.getRMSLevel(channel, 0, numSamples));
+        frame.peak = juce::jmax(frame.peak, static_cast<float>(buffer.getMagnitude(channel, 0, numSamples)));
+        sumOfSquares += rms * rms;
+    }
+    frame.rms = static_cast<float>(std::sqrt(sumOfSquares / juce::jmax(1, buffer.getNumChannels())));
+
+    // Positive dB the shaper and crusher took off; 0 when they added level or had no input
+    if (shaperInputEnergy > 0.0 && crusherOutputEnergy < shaperInputEnergy)
+        frame.reductionDb = -juce::Decibels::gainToDecibels(static_cast<float>(std::sqrt(crusherOutputEnergy / shaperInputEnergy)));
+
+    for (size_t stage = 0; stage < stageTicks.size(); ++stage)
+        frame.stageMicros[stage] = static_cast<float>(juce::Time::highResolutionTicksToSeconds(stageTicks[stage]) * 1.0e6);
+
+    frame.blockMicros = static_cast<float>(blockSeconds * 1.0e6);
+    frame.budgetPercent = static_cast<float>(100.0 * blockSeconds / deadlineSeconds);
+    frame.overruns = overrunCount;
+    telemetry.push(frame);
+}
+
+int MiniRiserAudioProcessor::getLookaheadSamples(bool enabled) const noexcept
+{
+    return enabled ? juce::roundToInt(currentSampleRate * transientLookaheadSeconds) : 0;
+}
+
+// Runs on the message thread; allocation is fine here and processing is suspended meanwhile
+template <typename SampleType>
+void MiniRiserAudioProcessor::prepareLatency()
+{
+    auto& chain = getChain<SampleType>();
+    lookaheadEnabled = parameters.transientLookahead->get();
+    chain.engine.setLookahead(getLookaheadSamples(lookaheadEnabled));
+    
+    oversamplingIndex = parameters.oversampling->getIndex();
+    oversamplingModeIndex = parameters.oversamplingMode->getIndex();
+
+    if (oversamplingIndex > 0) {
+        const auto filterType = oversamplingModeIndex == 1
+            ? juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple
+            : juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR;
+
+        chain.oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>(juce::jmax(size_t(1), effectChannels.size()),
+                                                                                   static_cast<size_t>(oversamplingIndex),
+                                                                                   filterType, true, true);
+        chain.oversampler->initProcessing(static_cast<size_t>(controlRateSamples));
+        latencySamples = juce::roundToInt(chain.oversampler->getLatencyInSamples());
+    } else {
+        chain.oversampler.reset();
+        latencySamples = 0;
+    }
+
+    latencySamples += chain.engine.getLatencySamples();
+
+    chain.dryDelay.prepare({ static_cast<double>(currentSampleRate), static_cast<juce::uint32>(controlRateSamples), static_cast<juce::uint32>(preparedChannels) });
+    chain.dryDelay.setMaximumDelayInSamples(juce::jmax(1, latencySamples));
+    chain.dryDelay.setDelay(static_cast<SampleType>(latencySamples));
+    chain.dryDelay.reset();
+
+    setLatencySamples(latencySamples);
+}
+
+void MiniRiserAudioProcessor::timerCallback()
+{
+    notifyParameterEventListeners();
+
+    if (! latencyChangePending.load(std::memory_order_acquire))
+        return;
+
+    suspendProcessing(true);
+    if (isUsingDoublePrecision())
+        prepareLatency<double>();
+    else
+        prepareLatency<float>();
+    latencyChangePending = false;
+    suspendProcessing(false);
+}
+
+template <typename SampleType>
+void MiniRiserAudioProcessor::compensateLatency(juce::dsp::AudioBlock<SampleType> block)
+{
+    if (latencySamples == 0)
+        return;
+
+    juce::dsp::ProcessContextReplacing<SampleType> context(block);
+    getChain<SampleType>().dryDelay.process(context);
+}
+
+// Stops at the first sample above the threshold, so a block with signal in it costs next to nothing
+template <typename SampleType>
+bool MiniRiserAudioProcessor::isSilent(const juce::AudioBuffer<SampleType>& buffer, int start, int numSamples) noexcept
+{
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+        const auto* data = buffer.getReadPointer(channel, start);
+        for (int i = 0; i < numSamples; ++i)
+            if (std::abs(data[i]) >= SampleType(silenceThreshold))
+                return false;
+    }
+
+    return true;
+}
+
+void MiniRiserAudioProcessor::updateProcessingState()
+{
+    const bool wantsEffect = impactSmoothed.getTargetValue() / 100.0f > 0.001f;
+
+    if (wantsEffect && processingState != ProcessingState::active) {
+        // Pick up from wherever the tails were left, or from zero after going idle
+        impactSmoothed.setCurrentAndTargetValue(heldImpact);
+        impactSmoothed.setTargetValue(parameters.impact->get());
+        sendLevel.setTargetValue(1.0f);
+        processingState = ProcessingState::active;
+        silentSamples = 0;
+    } else if (! wantsEffect && processingState == ProcessingState::active) {
+        heldImpact = impactSmoothed.getCurrentValue();
+        sendLevel.setTargetValue(0.0f);
+        processingState = ProcessingState::ringingOut;
+        silentSamples = 0;
+    }
+}
+
+void MiniRiserAudioProcessor::enterIdle()
+{
+    floatChain.reset();
+    doubleChain.reset();
+    sendLevel.setCurrentAndTargetValue(0.0f);
+    heldImpact = 0.0f;
+    lastControlImpact = -1.0f;
+    processingState = ProcessingState::idle;
+    silentSamples = 0;
+}
+
+template <typename SampleType>
+void MiniRiserAudioProcessor::processControlBlock(juce::dsp::AudioBlock<SampleType> block, float normalizedImpact)
+{
+    auto& chain = getChain<SampleType>();
+    auto& panGains = chain.panGains;
+    auto& targetPanGains = chain.targetPanGains;
+    size_t numChannels = 0;
+    for (; numChannels < panGains.size() && static_cast<size_t>(effectChannels[numChannels]) < block.getNumChannels(); ++numChannels)
+        chain.busChannels[numChannels] = block.getChannelPointer(static_cast<size_t>(effectChannels[numChannels]));
+    
+    // Makeup gain is ramped across each control block so Impact sweeps don't step
+    const float makeupGain = getMakeupGain(normalizedImpact);
+    
+    if (numChannels > 0) {
+        juce::dsp::AudioBlock<SampleType> busBlock(chain.busChannels.data(), numChannels, block.getNumSamples());
+        const int numSamples = static_cast<int>(block.getNumSamples());
+        const float panDepth = impactMapping.evaluate(riser::ImpactMapping::panDepth, normalizedImpact);
         
-        leftChain.processorChain.template get<EffectChain::reverbIndex>().process(leftContext);
-        rightChain.processorChain.template get<EffectChain::reverbIndex>().process(rightContext);
+        modulation.advance(numSamples);
+        float leftGain = 1.0f, rightGain = 1.0f;
+        if (panDepth > 0.0f)
+            modulation.getPanLaw().getGains(modulation.getValue(panLfoIndex) * panDepth, leftGain, rightGain);
+
+        bool unityPan = true;
+        for (size_t channel = 0; channel < numChannels; ++channel) {
+            const float side = channelPanSides[channel];
+            targetPanGains[channel] = static_cast<SampleType>(side < 0.0f ? leftGain : (side > 0.0f ? rightGain : 1.0f));
+            unityPan = unityPan && panGains[channel] == SampleType(1) && targetPanGains[channel] == SampleType(1);
+        }
+
+        const auto* panStart = unityPan ? nullptr : panGains.data();
+
+        using Stage = riser::TelemetryFrame::Stage;
+        auto& engine = chain.engine;
+        auto* oversampler = chain.oversampler.get();
+
+        if (oversampler == nullptr && ! measuringStages) {
+            engine.processPreReverb(busBlock, chain.engineParameters, panStart, targetPanGains.data());
+        } else {
+            timeStage(Stage::highPass, [&] { engine.processFilter(busBlock); });
+            if (measuringStages)
+                shaperInputEnergy += getEnergy(busBlock);
+            timeStage(Stage::transient, [&] { engine.processTransients(busBlock, chain.engineParameters); });
+            timeStage(Stage::crush, [&] {
+                if (oversampler != nullptr) {
+                    auto oversampledBlock = oversampler->processSamplesUp(busBlock);
+                    engine.processCrusher(oversampledBlock, chain.engineParameters, static_cast<SampleType>(oversampler->getOversamplingFactor()));
+                    oversampler->processSamplesDown(busBlock);
+                } else {
+                    engine.processCrusher(busBlock, chain.engineParameters, SampleType(1));
+                }
+            });
+            if (measuringStages)
+                crusherOutputEnergy += getEnergy(busBlock);
+            timeStage(Stage::pan, [&] { engine.processPan(busBlock, panStart, targetPanGains.data()); });
+        }
+        std::copy(targetPanGains.begin(), targetPanGains.begin() + static_cast<std::ptrdiff_t>(numChannels), panGains.begin());
         
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
-            float currentWetLevel = delayParams.wetLevel.getCurrentValue();
-            float currentFeedback = delayParams.feedback.getCurrentValue();
-            
-            for (int channel = 0; channel < 2; ++channel) {
-                auto* channelData = buffer.getWritePointer(channel);
-                auto* delayData = delayParams.delayBuffer.getWritePointer(channel);
-                
-                int readIndex = (delayParams.writeIndex - static_cast<int>(delayParams.delayTimeInSamples) + delayParams.delayBuffer.getNumSamples()) % delayParams.delayBuffer.getNumSamples();
-                
-                float delayedSample = delayData[readIndex];
-                float input = channelData[sample];
-                
-                // Proper mix: blend dry and wet signals instead of adding
-                float dryLevel = 1.0f - currentWetLevel;
-                float output = (input * dryLevel) + (delayedSample * currentWetLevel);
-                
-                delayData[delayParams.writeIndex] = input + (delayedSample * currentFeedback);
-                channelData[sample] = output;
-            }
-            
-            delayParams.writeIndex = (delayParams.writeIndex + 1) % delayParams.delayBuffer.getNumSamples();
+        timeStage(Stage::reverb, [&] { chain.reverb.process(busBlock); });
+        
+        auto* wetLevels = chain.delayLevels.getWritePointer(0);
+        auto* feedbackLevels = chain.delayLevels.getWritePointer(1);
+
+        for (int sample = 0; sample < numSamples; ++sample) {
+            wetLevels[sample] = static_cast<SampleType>(delayParams.wetLevel.getNextValue());
+            feedbackLevels[sample] = static_cast<SampleType>(delayParams.feedback.getNextValue());
         }
-    }
 
-    if (currentImpact > 0.25f) {
-        constexpr float gainCurveExponent = 1.0f;
-        const float normalizedImpact = juce::jlimit(0.0f, 1.0f, (currentImpact - 0.20f) / 0.75f);
-        const float shapedImpact = std::pow(normalizedImpact, gainCurveExponent);
-        const float gainDb = shapedImpact * 10.0f;
-        buffer.applyGain(juce::Decibels::decibelsToGain(gainDb));
+        const auto delayStart = static_cast<SampleType>(delayParams.timeInSamples.getCurrentValue());
+        const auto delayEnd = static_cast<SampleType>(delayParams.timeInSamples.skip(numSamples));
+        timeStage(Stage::delay, [&] {
+            engine.processPostReverb(busBlock, wetLevels, feedbackLevels, delayStart, delayEnd,
+                                     static_cast<SampleType>(lastMakeupGain), static_cast<SampleType>(makeupGain));
+        });
     }
+
+    lastMakeupGain = makeupGain;
 }
 
 bool MiniRiserAudioProcessor::hasEditor() const
@@ -333,17 +950,33 @@ bool MiniRiserAudioProcessor::hasEditor() const
 
 juce::AudioProcessorEditor* MiniRiserAudioProcessor::createEditor()
 {
+    // The build picks the default; MINIRISER_EDITOR=native or =web overrides it per session
+    const auto editorType = juce::SystemStats::getEnvironmentVariable("MINIRISER_EDITOR", {});
+    const bool native = editorType == "native" || (MINIRISER_NATIVE_EDITOR && editorType != "web");
+
+    if (native)
+        return new MiniRiserNativeEditor (*this);
+
     return new MiniRiserAudioProcessorEditor (*this);
 }
 
 void MiniRiserAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    auto xml = state.copyState().createXml();
-    copyXmlToBinary(*xml, destData);
+    riser::StateFormat::write(state, impactMapping, currentProgram, destData);
 }
 
 void MiniRiserAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
+    int program = currentProgram;
+    if (riser::StateFormat::read(data, sizeInBytes, state, impactMapping, program)) {
+        currentProgram = juce::jlimit(0, presets.getNumPresets() - 1, program);
+        return;
+    }
+
+    // Sessions saved before the binary format hold the parameter tree as XML, and predate
+    // editable mapping curves and programs
+    impactMapping.resetToDefaults();
+    currentProgram = 0;
     auto xmlState = getXmlFromBinary(data, sizeInBytes);
     if (xmlState.get() != nullptr)
         if (xmlState->hasTagName(state.state.getType()))
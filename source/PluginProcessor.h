@@ -1,9 +1,37 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "dsp/ChannelEngine.h"
+#include "dsp/FdnReverb.h"
+#include "dsp/ModulationEngine.h"
+#include "dsp/RiserEnvelope.h"
+#include "PresetBank.h"
+#include "RealtimeCheck.h"
+#include "ResourceTable.h"
+#include "StateFormat.h"
+#include "Telemetry.h"
+
+#ifndef MINIRISER_SIMD_ENGINE
+ #define MINIRISER_SIMD_ENGINE 1
+#endif
+
+#ifndef MINIRISER_NATIVE_EDITOR
+ #define MINIRISER_NATIVE_EDITOR 0
+#endif
+
+#ifndef MINIRISER_CLAP
+ #define MINIRISER_CLAP 0
+#endif
+
+#if MINIRISER_CLAP
+ #include <clap-juce-extensions/clap-juce-extensions.h>
+#endif
 
 class MiniRiserAudioProcessor : public juce::AudioProcessor,
-                                  public juce::AudioProcessorValueTreeState::Listener
+                               #if MINIRISER_CLAP
+                                public clap_juce_extensions::clap_juce_audio_processor_capabilities,
+                               #endif
+                                private juce::Timer
 {
 public:
     MiniRiserAudioProcessor();
@@ -17,6 +45,13 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
+
+   #if MINIRISER_CLAP
+    bool supportsDirectEvent (uint16_t spaceId, uint16_t type) override;
+    void handleDirectEvent (const clap_event_header_t* event, int sampleOffset) override;
+   #endif
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -38,62 +73,222 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
 
     juce::AudioProcessorValueTreeState& getState() { return state; }
+    riser::ImpactMapping& getImpactMapping() noexcept { return impactMapping; }
+    riser::TelemetryChannel& getTelemetry() noexcept { return telemetry; }
 
 private:
     struct Parameters {
         juce::AudioParameterFloat* impact{nullptr};
+        juce::AudioParameterChoice* crushMode{nullptr};
+        juce::AudioParameterBool* crushAntialias{nullptr};
+        juce::AudioParameterChoice* panShape{nullptr};
+        juce::AudioParameterChoice* panSync{nullptr};
+        juce::AudioParameterChoice* delaySync{nullptr};
+        juce::AudioParameterChoice* riseLength{nullptr};
+        juce::AudioParameterChoice* riseCurve{nullptr};
+        juce::AudioParameterChoice* oversampling{nullptr};
+        juce::AudioParameterChoice* oversamplingMode{nullptr};
+        juce::AudioParameterBool* transientLookahead{nullptr};
     };
     Parameters parameters;
     juce::AudioProcessorValueTreeState state;
+    riser::PresetBank presets;
+    std::atomic<int> currentProgram { 0 };
+
+    // Keeps the web UI's asset table alive while the plugin is loaded, not just while an
+    // editor is open, so reopening an editor doesn't rebuild it or inflate assets again
+    juce::SharedResourcePointer<riser::ResourceTable> editorResources;
     
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout(Parameters& parameters);
-    void parameterChanged(const juce::String& parameterID, float newValue) override;
 
     juce::SmoothedValue<float> impactSmoothed;
 
-    struct EffectChain {
-        juce::dsp::ProcessorChain<
-            juce::dsp::IIR::Filter<float>,           // High-pass filter
-            juce::dsp::Gain<float>,                  // Transient shaper (simplified as gain reduction)
-            juce::dsp::Gain<float>,                  // Bit crusher placeholder
-            juce::dsp::Panner<float>,                // Auto panner
-            juce::dsp::Reverb,                       // Reverb
-            juce::dsp::DelayLine<float>              // Delay
-        > processorChain;
-        
-        enum {
-            highPassIndex = 0,
-            transientShaperIndex,
-            bitCrusherIndex,
-            autoPannerIndex,
-            reverbIndex,
-            delayIndex
-        };
+    // Parameter changes the host sends as timestamped events (CLAP) instead of setting the
+    // parameters before the block. They're queued with their sample offset and applied at the
+    // control block that contains it, rather than all at the start of the block. Later values
+    // replace earlier ones per parameter on the nominal controlRateSamples grid, which bounds
+    // the queue at one entry per parameter and grid cell of the largest block.
+    // Listeners hear about the new values from the latency timer, not the audio thread.
+    struct ParameterEvent {
+        juce::AudioProcessorParameter* parameter{nullptr};
+        float value{0.0f};
+        int sampleOffset{0};
     };
+    std::vector<ParameterEvent> parameterEvents;
+    std::vector<int> lastParameterEvent;                // Queue index per parameter, -1 if none
+    std::vector<std::atomic<bool>> parameterEventsApplied;
+    int numParameterEvents = 0;
+    int nextParameterEvent = 0;
+    int maxEventControlBlocks = 1;
+
+   #if MINIRISER_CLAP
+    std::vector<std::pair<clap_id, juce::AudioProcessorParameter*>> clapParameters;     // Sorted by ID
+   #endif
+
+    void prepareParameterEvents(int maximumBlockSize);
+    void queueParameterEvent(juce::AudioProcessorParameter* parameter, float value, int sampleOffset) noexcept;
+    bool applyParameterEvents(int endSample) noexcept;
+    void notifyParameterEventListeners();
+
+   #if MINIRISER_SIMD_ENGINE
+    template <typename SampleType>
+    using EngineVector = juce::dsp::SIMDRegister<SampleType>;   // Several channels share one register
+   #else
+    template <typename SampleType>
+    using EngineVector = SampleType;                            // One channel at a time
+   #endif
+
+    // Everything that holds audio runs in the host's precision: hosts with a 64-bit mix engine
+    // get the double chain and no conversion passes. Control-rate state is shared by both.
+    template <typename SampleType>
+    struct Chain {
+        using Vector = EngineVector<SampleType>;
+
+        riser::ChannelEngine<Vector> engine;
+        typename riser::ChannelEngine<Vector>::Parameters engineParameters;
+        riser::FdnReverb<Vector> reverb;
+        typename riser::FdnReverb<Vector>::Parameters reverbParameters;
+
+        // Every high-pass filter shares one preallocated coefficient set updated in place
+        typename juce::dsp::IIR::Coefficients<SampleType>::Ptr highPassCoefficients;
+
+        // Per-sample delay levels for the current control block, and the bypass path's input
+        juce::AudioBuffer<SampleType> delayLevels, dryBuffer;
+        std::vector<SampleType> panGains, targetPanGains;
+
+        // The effect channels of the current control block, for a block view that skips LFE
+        std::vector<SampleType*> busChannels;
+
+        std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversampler;
+        juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None> dryDelay;
+
+        void reset()
+        {
+            engine.reset();
+            reverb.reset();
+        }
+    };
+
+    Chain<float> floatChain;
+    Chain<double> doubleChain;
+
+    template <typename SampleType>
+    Chain<SampleType>& getChain() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleChain;
+        else
+            return floatChain;
+    }
+
+    // Effect parameters are recomputed on the audio thread every controlRateSamples samples
+    // from the smoothed Impact value, so no allocation happens while processing.
+    static constexpr int controlRateSamples = 32;
+    // Impact reaches every target through editable curves compiled to lookup tables
+    riser::ImpactMapping impactMapping;
+    float lastControlImpact = -1.0f;
+    bool crushRateReduction = false;
+    float lastMakeupGain = 1.0f;
+    
+    // The auto-panner's LFO is evaluated once per control block and its equal-power gains
+    // are ramped across the block by the engine. Each channel of the bus pans with the left
+    // or right side it sits on; centre channels are left alone.
+    enum { panLfoIndex = 0 };
+    riser::ModulationEngine modulation;
+    std::vector<float> channelPanSides;
+
+    // LFE channels skip every effect and pass through dry, delayed to match the reported
+    // latency. The engine, reverb and oversampler only see the other channels, in bus order.
+    std::vector<int> effectChannels, lfeChannels;
     
-    EffectChain leftChain, rightChain;
+    // With a rise length set, Impact ramps from zero to the knob's value over that many bars.
+    // Like every Impact target the envelope is control-rate: it is read at the last sample of
+    // each control block, so the ramp needs no host automation and no parameter callbacks.
+    // A control block is cut short where a new cycle begins, and the block that begins it
+    // steps the makeup gain instead of ramping it, so the reset lands on its exact sample.
+    riser::RiserEnvelope riserEnvelope;
+    bool riseCycleStarting = false;
     
-    juce::dsp::Oscillator<float> lfoForPanning;
+    static constexpr int maxChannels = 16;
+    static float getPanSide(juce::AudioChannelSet::ChannelType type);
     
     float currentSampleRate = 44100.0f;
     
+    // The delay buffer is sized for maxDelaySeconds; synced times longer than that are clamped
+    static constexpr double maxDelaySeconds = 1.0;
+    static constexpr double freeDelaySeconds = 0.125;
+    static constexpr float reverbDecaySeconds = 2.5f;
+    // Gain staging of the juce::Reverb pair this reverb replaced: it scaled the dry level by 2
+    // and the wet by 3, and its tail ran 0.54x the level of this network's for white noise
+    static constexpr float reverbDryScale = 2.0f;
+    static constexpr float reverbWetScale = 1.63f;
+    double hostTempo = 120.0;
+    
     struct DelayParams {
         juce::SmoothedValue<float> wetLevel;
         juce::SmoothedValue<float> feedback;
-        float delayTimeInSamples = 0.0f;
-        juce::AudioBuffer<float> delayBuffer;
-        int writeIndex = 0;
+        juce::SmoothedValue<float> timeInSamples;
     };
     DelayParams delayParams;
     
-    struct BitCrusherParams {
-        float bitDepth = 24.0f;
-        float quantizationStep = 0.0f;
-    };
-    BitCrusherParams bitCrusherParams;
+    // Bypass state machine. Turning Impact off stops feeding the effects but lets their tails
+    // ring out on top of the untouched input; once nothing above silenceThreshold can still be
+    // in flight, processing goes idle. While active, silent input over decayed tails is skipped.
+    enum class ProcessingState { active, ringingOut, idle };
+    ProcessingState processingState = ProcessingState::idle;
+    juce::SmoothedValue<float> sendLevel;
+    float heldImpact = 0.0f;
+    int silentSamples = 0;
+    int silenceHoldSamples = 0;
+    static constexpr float silenceThreshold = 1.0e-5f;     // -100 dBFS
+    
+    void updateProcessingState();
+    void enterIdle();
+    template <typename SampleType> static bool isSilent(const juce::AudioBuffer<SampleType>& buffer, int start, int numSamples) noexcept;
+    
+    // Optional 2x/4x/8x oversampling around the bit crusher only, with minimum-phase (IIR) or
+    // linear-phase (FIR) polyphase half-band filters, plus the transient shaper's optional
+    // lookahead. Switching either rebuilds on the message thread and reports the summed
+    // latency; the bypass path is delayed to match. The audio thread only raises a flag that a
+    // message-thread timer polls, since posting a message from processBlock locks and allocates.
+    int oversamplingIndex = -1;
+    int oversamplingModeIndex = -1;
+    bool lookaheadEnabled = false;
+    int latencySamples = 0;
+    int preparedChannels = 0;
+    std::atomic<bool> latencyChangePending { false };
+    static constexpr double transientLookaheadSeconds = 0.002;
+    static constexpr int latencyPollHz = 20;
     
-    float applyBitCrushing(float sample, float bitDepth);
-    void updateEffectParameters(float impactValue);
+    int getLookaheadSamples(bool enabled) const noexcept;
+    
+    void timerCallback() override;
+    
+    // Per-block levels, stage timings and deadline overruns for the editor. Overruns are
+    // counted all the time; everything else is only measured while the editor's overlay is shown.
+    // Measuring splits the fused pre-reverb pass so each of its stages can be timed, and so
+    // the bus energy going into the transient shaper and out of the crusher can be compared.
+    riser::TelemetryChannel telemetry;
+    bool measuringStages = false;
+    std::array<juce::int64, riser::TelemetryFrame::numStages> stageTicks {};
+    double shaperInputEnergy = 0.0, crusherOutputEnergy = 0.0;
+    juce::uint32 blockCount = 0;
+    juce::uint32 overrunCount = 0;
+    
+    template <typename Function> void timeStage(int stage, Function&& function);
+    template <typename SampleType> static double getEnergy(const juce::dsp::AudioBlock<SampleType>& block) noexcept;
+    template <typename SampleType> void publishTelemetry(const juce::AudioBuffer<SampleType>& buffer, juce::int64 startTicks);
+
+    template <typename SampleType> void prepareChain(double sampleRate, int samplesPerBlock);
+    template <typename SampleType> void prepareLatency();
+    template <typename SampleType> void process(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType> void compensateLatency(juce::dsp::AudioBlock<SampleType> block);
+    template <typename SampleType> void updateEffectParameters(float impactValue);
+    template <typename SampleType> void processControlBlock(juce::dsp::AudioBlock<SampleType> block, float normalizedImpact);
+    void updateModulation(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position);
+    void updateDelayTime(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position);
+    void updateRiserEnvelope(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, int numSamples);
+    float getMakeupGain(float normalizedImpact) const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MiniRiserAudioProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "PresetBank.h"
+
+namespace riser
+{
+    namespace
+    {
+        // Plain (unnormalised) values; choice parameters take their index. Quality settings
+        // such as oversampling are left alone so recalling a preset never changes latency.
+        struct FactoryPreset {
+            const char* name;
+            float impact, crushMode, crushAntialias, panShape, panSync, delaySync;
+        };
+
+        constexpr FactoryPreset factoryPresets[] = {
+            //  name              impact  crush  aa    shape  panSync  delaySync
+            { "Init",             0.0f,   0,     1,    0,     0,       0 },
+            { "Gentle Lift",      35.0f,  0,     1,    0,     0,       0 },
+            { "Build",            60.0f,  0,     1,    0,     3,       2 },
+            { "Crushed Rise",     80.0f,  1,     1,    1,     4,       4 },
+            { "Wide Sweep",       70.0f,  0,     1,    2,     2,       1 },
+            { "Full Send",        100.0f, 1,     0,    3,     5,       3 },
+        };
+    }
+
+    PresetBank::PresetBank(juce::AudioProcessorValueTreeState& state)
+    {
+        const auto resolve = [&state](const char* parameterId, float plainValue) {
+            auto* parameter = state.getParameter(parameterId);
+            jassert (parameter != nullptr);
+            return Setting { parameter, parameter->convertTo0to1(plainValue) };
+        };
+
+        for (const auto& factoryPreset : factoryPresets) {
+            auto& preset = presets.emplace_back();
+            preset.name = factoryPreset.name;
+            preset.settings = {
+                resolve("impact", factoryPreset.impact),
+                resolve("crushMode", factoryPreset.crushMode),
+                resolve("crushAntialias", factoryPreset.crushAntialias),
+                resolve("panShape", factoryPreset.panShape),
+                resolve("panSync", factoryPreset.panSync),
+                resolve("delaySync", factoryPreset.delaySync),
+            };
+        }
+    }
+
+    void PresetBank::apply(int index) const noexcept
+    {
+        if (! juce::isPositiveAndBelow(index, getNumPresets()))
+            return;
+
+        for (const auto& setting : presets[static_cast<size_t>(index)].settings)
+            setting.parameter->setValueNotifyingHost(setting.normalisedValue);
+    }
+}
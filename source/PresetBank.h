@@ -0,0 +1,33 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace riser
+{
+    // Factory programs exposed to the host. Every preset is resolved to parameter pointers and
+    // normalised values when the bank is built, so switching programs is a walk over a short
+    // array of setValueNotifyingHost calls: no lookups, no parsing and no allocation.
+    class PresetBank
+    {
+    public:
+        explicit PresetBank(juce::AudioProcessorValueTreeState& state);
+
+        int getNumPresets() const noexcept                      { return static_cast<int>(presets.size()); }
+        const juce::String& getName(int index) const            { return presets[static_cast<size_t>(index)].name; }
+
+        void apply(int index) const noexcept;
+
+    private:
+        struct Setting {
+            juce::RangedAudioParameter* parameter = nullptr;
+            float normalisedValue = 0.0f;
+        };
+
+        struct Preset {
+            juce::String name;
+            std::vector<Setting> settings;
+        };
+
+        std::vector<Preset> presets;
+    };
+}
@@ -0,0 +1,337 @@
+#include "RealtimeCheck.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if MINIRISER_RT_CHECK && JUCE_LINUX && defined (__GLIBC__)
+ #define MINIRISER_RT_CHECK_GLIBC 1
+ #include <dlfcn.h>
+ #include <poll.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <time.h>
+
+// glibc's own entry points, which the hooks below forward to without being hooked themselves
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void* __libc_memalign(size_t, size_t);
+extern "C" void __libc_free(void*);
+#else
+ #define MINIRISER_RT_CHECK_GLIBC 0
+#endif
+
+#if ! JUCE_WINDOWS
+ #include <unistd.h>
+#endif
+
+// The hooks may be reached from a thread's very first allocation; initial-exec TLS is set up
+// with the thread, so reading these never allocates
+#if JUCE_LINUX
+ #define MINIRISER_RT_THREAD_LOCAL thread_local __attribute__((tls_model("initial-exec")))
+#else
+ #define MINIRISER_RT_THREAD_LOCAL thread_local
+#endif
+
+namespace riser
+{
+    namespace
+    {
+        std::array<std::atomic<int>, RealtimeCheck::numViolations> counts {};
+        std::atomic<bool> trapOnViolation { false };
+        std::atomic<int> messagesLeft { 100 };
+
+        MINIRISER_RT_THREAD_LOCAL int scopeDepth = 0;
+        MINIRISER_RT_THREAD_LOCAL bool reporting = false;
+
+        // No stdio buffering: nothing here may allocate
+        void writeToStderr(const char* text) noexcept
+        {
+           #if JUCE_WINDOWS
+            std::fputs(text, stderr);
+           #else
+            juce::ignoreUnused (::write(STDERR_FILENO, text, std::strlen(text)));
+           #endif
+        }
+    }
+
+   #if MINIRISER_RT_CHECK
+    RealtimeCheck::Scope::Scope() noexcept
+    {
+        ++scopeDepth;
+    }
+
+    RealtimeCheck::Scope::~Scope()
+    {
+        --scopeDepth;
+    }
+   #endif
+
+    void RealtimeCheck::report(Violation violation, const char* function) noexcept
+    {
+        if (scopeDepth == 0 || reporting)
+            return;
+
+        // Whatever reporting calls itself is not the audio code's fault
+        reporting = true;
+        ++counts[static_cast<size_t>(violation)];
+
+        if (trapOnViolation || messagesLeft-- > 0) {
+            writeToStderr("[rt-check] ");
+            writeToStderr(getViolationName(violation));
+            writeToStderr(" on the audio thread: ");
+            writeToStderr(function);
+            writeToStderr("\n");
+        }
+
+        // A debugger stops on the abort with the offending call still on the stack
+        if (trapOnViolation)
+            std::abort();
+
+        reporting = false;
+    }
+
+    int RealtimeCheck::getCount(Violation violation) noexcept
+    {
+        return counts[static_cast<size_t>(violation)];
+    }
+
+    void RealtimeCheck::resetCounts() noexcept
+    {
+        for (auto& count : counts)
+            count = 0;
+    }
+
+    const char* RealtimeCheck::getViolationName(Violation violation) noexcept
+    {
+        switch (violation) {
+            case allocation:    return "heap allocation";
+            case lock:          return "lock";
+            case blockingCall:  return "blocking call";
+            case numViolations: break;
+        }
+
+        return "";
+    }
+
+    void RealtimeCheck::setTrapOnViolation(bool shouldTrap) noexcept
+    {
+        trapOnViolation = shouldTrap;
+    }
+}
+
+#if MINIRISER_RT_CHECK
+namespace
+{
+    using riser::RealtimeCheck;
+
+    // With glibc's malloc hooked below, operator new goes straight to the unhooked allocator so
+    // every allocation is reported once
+    void* allocate(std::size_t size) noexcept
+    {
+       #if MINIRISER_RT_CHECK_GLIBC
+        return __libc_malloc(size == 0 ? 1 : size);
+       #else
+        return std::malloc(size == 0 ? 1 : size);
+       #endif
+    }
+
+    void* allocateAligned(std::size_t size, std::size_t alignment) noexcept
+    {
+       #if MINIRISER_RT_CHECK_GLIBC
+        return __libc_memalign(alignment, size == 0 ? 1 : size);
+       #elif JUCE_WINDOWS
+        return _aligned_malloc(size == 0 ? 1 : size, alignment);
+       #else
+        void* pointer = nullptr;
+        return posix_memalign(&pointer, juce::jmax(alignment, sizeof(void*)), size == 0 ? 1 : size) == 0 ? pointer : nullptr;
+       #endif
+    }
+
+    void release(void* pointer) noexcept
+    {
+       #if MINIRISER_RT_CHECK_GLIBC
+        __libc_free(pointer);
+       #else
+        std::free(pointer);
+       #endif
+    }
+
+    void releaseAligned(void* pointer) noexcept
+    {
+       #if JUCE_WINDOWS
+        _aligned_free(pointer);
+       #else
+        release(pointer);
+       #endif
+    }
+
+    void* checkedNew(std::size_t size, const char* function)
+    {
+        RealtimeCheck::report(RealtimeCheck::allocation, function);
+        if (auto* pointer = allocate(size))
+            return pointer;
+
+        throw std::bad_alloc();
+    }
+
+    void* checkedNewAligned(std::size_t size, std::align_val_t alignment, const char* function)
+    {
+        RealtimeCheck::report(RealtimeCheck::allocation, function);
+        if (auto* pointer = allocateAligned(size, static_cast<std::size_t>(alignment)))
+            return pointer;
+
+        throw std::bad_alloc();
+    }
+
+    void checkedDelete(void* pointer) noexcept
+    {
+        if (pointer != nullptr)
+            RealtimeCheck::report(RealtimeCheck::allocation, "operator delete");
+
+        release(pointer);
+    }
+
+    void checkedDeleteAligned(void* pointer) noexcept
+    {
+        if (pointer != nullptr)
+            RealtimeCheck::report(RealtimeCheck::allocation, "operator delete");
+
+        releaseAligned(pointer);
+    }
+}
+
+void* operator new(std::size_t size)                                            { return checkedNew(size, "operator new"); }
+void* operator new[](std::size_t size)                                          { return checkedNew(size, "operator new[]"); }
+void* operator new(std::size_t size, std::align_val_t alignment)                { return checkedNewAligned(size, alignment, "operator new"); }
+void* operator new[](std::size_t size, std::align_val_t alignment)              { return checkedNewAligned(size, alignment, "operator new[]"); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    RealtimeCheck::report(RealtimeCheck::allocation, "operator new");
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    RealtimeCheck::report(RealtimeCheck::allocation, "operator new[]");
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept                                    { checkedDelete(pointer); }
+void operator delete[](void* pointer) noexcept                                  { checkedDelete(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept                       { checkedDelete(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept                     { checkedDelete(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept             { checkedDelete(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept           { checkedDelete(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept                  { checkedDeleteAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept                { checkedDeleteAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept     { checkedDeleteAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept   { checkedDeleteAligned(pointer); }
+#endif
+
+#if MINIRISER_RT_CHECK_GLIBC
+//==============================================================================
+extern "C"
+{
+    void* malloc(size_t size)
+    {
+        RealtimeCheck::report(RealtimeCheck::allocation, "malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        RealtimeCheck::report(RealtimeCheck::allocation, "calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        RealtimeCheck::report(RealtimeCheck::allocation, "realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        RealtimeCheck::report(RealtimeCheck::allocation, "memalign");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        RealtimeCheck::report(RealtimeCheck::allocation, "aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size)
+    {
+        RealtimeCheck::report(RealtimeCheck::allocation, "posix_memalign");
+        if (auto* pointer = __libc_memalign(alignment, size)) {
+            *result = pointer;
+            return 0;
+        }
+
+        return ENOMEM;
+    }
+
+    void free(void* pointer)
+    {
+        if (pointer != nullptr)
+            RealtimeCheck::report(RealtimeCheck::allocation, "free");
+
+        __libc_free(pointer);
+    }
+}
+
+//==============================================================================
+namespace
+{
+    // Looked up on first use; the cache is constant-initialised, so there is no static guard
+    // to take a lock on the way in
+    template <typename Function>
+    Function* findNext(std::atomic<void*>& cache, const char* name) noexcept
+    {
+        auto* function = cache.load(std::memory_order_relaxed);
+        if (function == nullptr) {
+            function = dlsym(RTLD_NEXT, name);
+            cache.store(function, std::memory_order_relaxed);
+        }
+
+        return reinterpret_cast<Function*>(function);
+    }
+}
+
+// Reports the call, then forwards it to the next definition in link order (libc or libpthread)
+#define MINIRISER_RT_HOOK(violation, name, result, parameters, arguments) \
+    result name parameters \
+    { \
+        RealtimeCheck::report(RealtimeCheck::violation, #name); \
+        static std::atomic<void*> next { nullptr }; \
+        return findNext<result parameters>(next, #name) arguments; \
+    }
+
+extern "C"
+{
+    MINIRISER_RT_HOOK(lock, pthread_mutex_lock, int, (pthread_mutex_t* mutex) noexcept, (mutex))
+    MINIRISER_RT_HOOK(lock, pthread_rwlock_rdlock, int, (pthread_rwlock_t* rwlock) noexcept, (rwlock))
+    MINIRISER_RT_HOOK(lock, pthread_rwlock_wrlock, int, (pthread_rwlock_t* rwlock) noexcept, (rwlock))
+    MINIRISER_RT_HOOK(lock, sem_wait, int, (sem_t* semaphore), (semaphore))
+
+    MINIRISER_RT_HOOK(blockingCall, pthread_cond_wait, int, (pthread_cond_t* condition, pthread_mutex_t* mutex), (condition, mutex))
+    MINIRISER_RT_HOOK(blockingCall, pthread_cond_timedwait, int, (pthread_cond_t* condition, pthread_mutex_t* mutex, const timespec* time), (condition, mutex, time))
+    MINIRISER_RT_HOOK(blockingCall, pthread_join, int, (pthread_t thread, void** result), (thread, result))
+    MINIRISER_RT_HOOK(blockingCall, nanosleep, int, (const timespec* duration, timespec* remaining), (duration, remaining))
+    MINIRISER_RT_HOOK(blockingCall, clock_nanosleep, int, (clockid_t clock, int flags, const timespec* duration, timespec* remaining), (clock, flags, duration, remaining))
+    MINIRISER_RT_HOOK(blockingCall, usleep, int, (useconds_t microseconds), (microseconds))
+    MINIRISER_RT_HOOK(blockingCall, sleep, unsigned int, (unsigned int seconds), (seconds))
+    MINIRISER_RT_HOOK(blockingCall, read, ssize_t, (int file, void* buffer, size_t size), (file, buffer, size))
+    MINIRISER_RT_HOOK(blockingCall, write, ssize_t, (int file, const void* buffer, size_t size), (file, buffer, size))
+    MINIRISER_RT_HOOK(blockingCall, poll, int, (pollfd* files, nfds_t count, int timeout), (files, count, timeout))
+}
+
+#undef MINIRISER_RT_HOOK
+#endif
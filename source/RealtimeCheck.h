@@ -0,0 +1,52 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MINIRISER_RT_CHECK
+ #define MINIRISER_RT_CHECK 0
+#endif
+
+namespace riser
+{
+    // Debug instrumentation for real-time safety, compiled in with MINIRISER_RT_CHECK. A thread
+    // inside a Scope counts as an audio thread: heap allocations and frees, mutex locks and
+    // blocking calls such as sleeps, condition waits and file I/O made from it are counted and
+    // logged to stderr, or abort on the spot so a debugger stops at the offending call.
+    // Without the option a Scope compiles to nothing.
+    //
+    // operator new and delete are replaced on every platform; malloc and friends, locks and
+    // blocking calls are hooked on Linux (glibc) only. The hooks replace global symbols, which
+    // is only dependable inside an executable: run MiniRiserRealtimeCheck rather than loading
+    // an instrumented plugin into a host.
+    class RealtimeCheck
+    {
+    public:
+        enum Violation { allocation, lock, blockingCall, numViolations };
+
+        // Scopes nest, so the processor can mark processBlock while a driver also marks the
+        // automation it applies around it
+        class Scope
+        {
+        public:
+           #if MINIRISER_RT_CHECK
+            Scope() noexcept;
+            ~Scope();
+           #else
+            Scope() noexcept {}
+           #endif
+
+            JUCE_DECLARE_NON_COPYABLE (Scope)
+        };
+
+        static constexpr bool isEnabled() noexcept              { return MINIRISER_RT_CHECK != 0; }
+
+        // Called by the hooks; ignored outside a Scope
+        static void report(Violation violation, const char* function) noexcept;
+
+        static int getCount(Violation violation) noexcept;
+        static void resetCounts() noexcept;
+        static const char* getViolationName(Violation violation) noexcept;
+
+        static void setTrapOnViolation(bool shouldTrap) noexcept;
+    };
+}
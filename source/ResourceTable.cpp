@@ -0,0 +1,95 @@
+#include "ResourceTable.h"
+
+namespace riser
+{
+    ResourceTable::ResourceTable()
+    {
+        entries.reserve(static_cast<size_t>(BinaryData::namedResourceListSize));
+
+        for (int i = 0; i < BinaryData::namedResourceListSize; ++i) {
+            int size = 0;
+            const auto* data = BinaryData::getNamedResource(BinaryData::namedResourceList[i], size);
+            const juce::String fileName(BinaryData::originalFilenames[i]);
+
+            if (data == nullptr || size <= 0)
+                continue;
+
+            if (fileName.endsWithIgnoreCase(".gz"))
+                add(fileName.dropLastCharacters(3), data, size, true);
+            else
+                add(fileName, data, size, false);
+        }
+    }
+
+    void ResourceTable::add(const juce::String& fileName, const char* data, int size, bool compressed)
+    {
+        // A pre-compressed asset and its plain twin resolve to whichever was listed first
+        if (indexByName.contains(fileName))
+            return;
+
+        indexByName.set(fileName, static_cast<int>(entries.size()));
+
+        auto& entry = entries.emplace_back();
+        entry.asset.mimeType = getMimeType(fileName);
+
+        if (compressed) {
+            entry.compressedData = data;
+            entry.compressedSize = size;
+        } else {
+            entry.asset.data = reinterpret_cast<const std::byte*>(data);
+            entry.asset.size = static_cast<size_t>(size);
+        }
+    }
+
+    const ResourceTable::Asset* ResourceTable::find(const juce::String& url)
+    {
+        const auto path = url.upToFirstOccurrenceOf("?", false, false);
+        const auto fileName = path == "/" || path.isEmpty() ? juce::String("index.html")
+                                                            : path.fromLastOccurrenceOf("/", false, false);
+
+        if (! indexByName.contains(fileName)) {
+           #if MINIRISER_LOG_RESOURCES
+            juce::Logger::writeToLog("MRS-R: no resource for " + url);
+           #endif
+            return nullptr;
+        }
+
+       #if MINIRISER_LOG_RESOURCES
+        juce::Logger::writeToLog("MRS-R: serving " + url + " from " + fileName);
+       #endif
+        auto& entry = entries[static_cast<size_t>(indexByName[fileName])];
+
+        const juce::ScopedLock lock(inflateLock);
+        if (entry.compressedData != nullptr) {
+            juce::MemoryInputStream compressed(entry.compressedData, static_cast<size_t>(entry.compressedSize), false);
+            juce::GZIPDecompressorInputStream inflater(&compressed, false, juce::GZIPDecompressorInputStream::gzipFormat);
+            inflater.readIntoMemoryBlock(entry.inflated);
+
+            entry.asset.data = static_cast<const std::byte*>(entry.inflated.getData());
+            entry.asset.size = entry.inflated.getSize();
+            entry.compressedData = nullptr;
+        }
+
+        return &entry.asset;
+    }
+
+    juce::String ResourceTable::getMimeType(const juce::String& fileName)
+    {
+        const auto extension = fileName.fromLastOccurrenceOf(".", false, false).toLowerCase();
+
+        if (extension == "html")                        return "text/html";
+        if (extension == "css")                         return "text/css";
+        if (extension == "js" || extension == "mjs")    return "application/javascript";
+        if (extension == "json")                        return "application/json";
+        if (extension == "png")                         return "image/png";
+        if (extension == "jpg" || extension == "jpeg")  return "image/jpeg";
+        if (extension == "gif")                         return "image/gif";
+        if (extension == "svg")                         return "image/svg+xml";
+        if (extension == "ico")                         return "image/x-icon";
+        if (extension == "woff")                        return "font/woff";
+        if (extension == "woff2")                       return "font/woff2";
+        if (extension == "ttf")                         return "font/ttf";
+        if (extension == "otf")                         return "font/otf";
+        return "application/octet-stream";
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MINIRISER_LOG_RESOURCES
+ #define MINIRISER_LOG_RESOURCES 0
+#endif
+
+namespace riser
+{
+    // Index of the web UI assets compiled into BinaryData. Processors and editors hold it
+    // through a juce::SharedResourcePointer, so every instance in the process shares one table
+    // and it lives as long as any instance does; closing and reopening an editor reuses it.
+    // Lookups are a hash of the requested file name, and the asset bytes are the BinaryData
+    // arrays themselves, so nothing is copied until a request is answered. Assets stored
+    // pre-compressed as name.gz are served under their plain name, inflated on first request
+    // and kept; instances that never open an editor never inflate anything.
+    class ResourceTable
+    {
+    public:
+        struct Asset {
+            const std::byte* data = nullptr;
+            size_t size = 0;
+            juce::String mimeType;
+        };
+
+        ResourceTable();
+
+        // url is the path the WebView asked for; "/" maps to index.html. Returns null if unknown.
+        // Safe from any thread; the first request for a compressed asset inflates it.
+        const Asset* find(const juce::String& url);
+
+        static juce::String getMimeType(const juce::String& fileName);
+
+    private:
+        struct Entry {
+            Asset asset;
+            const char* compressedData = nullptr;   // Gzip bytes, until inflated into asset
+            int compressedSize = 0;
+            juce::MemoryBlock inflated;
+        };
+
+        void add(const juce::String& fileName, const char* data, int size, bool compressed);
+
+        std::vector<Entry> entries;
+        juce::HashMap<juce::String, int> indexByName;
+        juce::CriticalSection inflateLock;
+    };
+}
@@ -0,0 +1,118 @@
+#include "StateFormat.h"
+
+namespace riser
+{
+    void StateFormat::write(juce::AudioProcessorValueTreeState& state, const ImpactMapping& mapping,
+                            int currentProgram, juce::MemoryBlock& destination)
+    {
+        juce::Array<juce::RangedAudioParameter*> parameters;
+        for (auto* parameter : state.processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+                parameters.add(ranged);
+
+        juce::MemoryOutputStream stream(destination, false);
+        stream.writeInt(magic);
+        stream.writeInt(currentVersion);
+        stream.writeInt(currentProgram);
+        stream.writeCompressedInt(parameters.size());
+
+        for (auto* parameter : parameters) {
+            stream.writeString(parameter->getParameterID());
+            stream.writeFloat(parameter->convertFrom0to1(parameter->getValue()));
+        }
+
+        stream.writeCompressedInt(ImpactMapping::numTargets);
+
+        for (int target = 0; target < ImpactMapping::numTargets; ++target) {
+            const auto& curve = mapping.getCurve(static_cast<ImpactMapping::Target>(target));
+            stream.writeString(ImpactMapping::getTargetName(static_cast<ImpactMapping::Target>(target)));
+            stream.writeCompressedInt(static_cast<int>(curve.size()));
+
+            for (const auto& point : curve) {
+                stream.writeFloat(point.x);
+                stream.writeFloat(point.y);
+                stream.writeFloat(point.tension);
+            }
+        }
+    }
+
+    bool StateFormat::read(const void* data, int sizeInBytes, juce::AudioProcessorValueTreeState& state,
+                           ImpactMapping& mapping, int& currentProgram)
+    {
+        if (data == nullptr || sizeInBytes < 12)
+            return false;
+
+        juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+        if (stream.readInt() != magic)
+            return false;
+
+        Contents contents;
+        contents.version = stream.readInt();
+        contents.program = stream.readInt();
+        const auto numEntries = stream.readCompressedInt();
+
+        for (int i = 0; i < numEntries && ! stream.isExhausted(); ++i) {
+            auto parameterId = stream.readString();
+            const auto plainValue = stream.readFloat();
+            contents.parameters.emplace_back(std::move(parameterId), plainValue);
+        }
+
+        if (contents.version >= 2)
+            readCurves(stream, contents);
+
+        migrate(contents);
+
+        for (const auto& [parameterId, plainValue] : contents.parameters)
+            if (auto* parameter = state.getParameter(parameterId))
+                parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+
+        mapping.resetToDefaults();
+        for (auto& [name, curve] : contents.curves)
+            for (int target = 0; target < ImpactMapping::numTargets; ++target)
+                if (name == ImpactMapping::getTargetName(static_cast<ImpactMapping::Target>(target)))
+                    mapping.setCurve(static_cast<ImpactMapping::Target>(target), std::move(curve));
+
+        currentProgram = contents.program;
+        return true;
+    }
+
+    void StateFormat::readCurves(juce::MemoryInputStream& stream, Contents& contents)
+    {
+        const auto numCurves = stream.readCompressedInt();
+
+        for (int i = 0; i < numCurves && ! stream.isExhausted(); ++i) {
+            auto name = stream.readString();
+            const auto numPoints = stream.readCompressedInt();
+
+            ImpactMapping::Curve curve;
+            for (int point = 0; point < numPoints && ! stream.isExhausted(); ++point) {
+                const auto x = stream.readFloat();
+                const auto y = stream.readFloat();
+                const auto tension = stream.readFloat();
+                curve.push_back({ x, y, tension });
+            }
+
+            contents.curves.emplace_back(std::move(name), std::move(curve));
+        }
+    }
+
+    // One step per format version, applied in order. Renamed parameters and changed ranges
+    // belong in the step for the version that changed them.
+    void StateFormat::migrate(Contents& contents)
+    {
+        if (contents.version < 2)
+            migrateFromVersion1(contents);
+    }
+
+    // Version 1 predates the Impact mapping: its curves were the fixed formulas the default
+    // curves reproduce
+    void StateFormat::migrateFromVersion1(Contents& contents)
+    {
+        contents.curves.clear();
+        for (int target = 0; target < ImpactMapping::numTargets; ++target)
+            contents.curves.emplace_back(ImpactMapping::getTargetName(static_cast<ImpactMapping::Target>(target)),
+                                         ImpactMapping::getDefaultCurve(static_cast<ImpactMapping::Target>(target)));
+
+        contents.version = 2;
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "dsp/ImpactMapping.h"
+
+namespace riser
+{
+    // Binary plugin state. Layout, all little-endian:
+    //
+    //   int32    magic ('MRSR')
+    //   int32    format version
+    //   int32    current program
+    //   packed   number of parameter entries
+    //   entries  parameter ID (null-terminated UTF-8) + float32 plain value
+    //
+    // Version 2 appends the Impact mapping curves:
+    //
+    //   packed   number of curves
+    //   curves   target name (null-terminated UTF-8), packed point count,
+    //            then x, y, tension as float32 for every point
+    //
+    // Entries are keyed by ID, so a state saved before a parameter existed leaves that
+    // parameter at its default, and IDs this build doesn't know are skipped. A newer version
+    // may append sections after the entries; older readers stop at the end of the entries and
+    // ignore them. Curves are keyed by target name in the same way; migrating a version 1 state
+    // gives it the default curves. States saved before this format (APVTS XML) are still read.
+    struct StateFormat
+    {
+        static constexpr int magic = 0x5253524d;    // "MRSR" read as little-endian bytes
+        static constexpr int currentVersion = 2;
+
+        static void write(juce::AudioProcessorValueTreeState& state, const ImpactMapping& mapping,
+                          int currentProgram, juce::MemoryBlock& destination);
+
+        // Returns false if the data isn't in this format at all; the caller may then try the
+        // legacy XML layout. currentProgram is only written if the state carries one.
+        static bool read(const void* data, int sizeInBytes, juce::AudioProcessorValueTreeState& state,
+                         ImpactMapping& mapping, int& currentProgram);
+
+    private:
+        // A state as it was read, before it's applied. migrate() brings it up to currentVersion
+        // one version at a time, so every older layout loads through the same steps.
+        struct Contents {
+            int version = 0;
+            int program = 0;
+            std::vector<std::pair<juce::String, float>> parameters;
+            std::vector<std::pair<juce::String, ImpactMapping::Curve>> curves;
+        };
+
+        static void readCurves(juce::MemoryInputStream& stream, Contents& contents);
+        static void migrate(Contents& contents);
+        static void migrateFromVersion1(Contents& contents);
+    };
+}
@@ -0,0 +1,56 @@
+#include "Telemetry.h"
+
+namespace riser
+{
+    const char* TelemetryFrame::getStageName(int stage) noexcept
+    {
+        switch (stage) {
+            case highPass:  return "highPass";
+            case transient: return "transient";
+            case crush:     return "crush";
+            case pan:       return "pan";
+            case reverb:    return "reverb";
+            case delay:     return "delay";
+            default:        return "";
+        }
+    }
+
+    //==============================================================================
+    static int getNextInstanceId() noexcept
+    {
+        static std::atomic<int> nextInstanceId { 1 };
+        return nextInstanceId++;
+    }
+
+    TelemetryChannel::TelemetryChannel(int capacity)
+        : fifo(capacity), frames(static_cast<size_t>(capacity)), instanceId(getNextInstanceId())
+    {
+    }
+
+    void TelemetryChannel::push(TelemetryFrame frame) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 + size2 == 0) {
+            ++droppedFrames;
+            return;
+        }
+
+        frame.droppedFrames = droppedFrames;
+        frames[static_cast<size_t>(size1 > 0 ? start1 : start2)] = frame;
+        fifo.finishedWrite(1);
+    }
+
+    int TelemetryChannel::pop(TelemetryFrame* destination, int maxFrames) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(maxFrames, start1, size1, start2, size2);
+
+        std::copy_n(frames.begin() + start1, size1, destination);
+        std::copy_n(frames.begin() + start2, size2, destination + size1);
+
+        fifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace riser
+{
+    // What one processBlock call did, as seen from the audio thread
+    struct TelemetryFrame {
+        enum Stage { highPass, transient, crush, pan, reverb, delay, numStages };
+
+        juce::uint32 blockIndex = 0;
+        int numSamples = 0;
+        float peak = 0.0f, rms = 0.0f;                  // Output, across every channel
+        float reductionDb = 0.0f;                       // Level the transient shaper and crusher took off
+        std::array<float, numStages> stageMicros {};
+        float blockMicros = 0.0f;
+        float budgetPercent = 0.0f;                     // Block time as a share of its real-time deadline
+        juce::uint32 overruns = 0;                      // Blocks so far that took longer than their deadline
+        juce::uint32 droppedFrames = 0;                 // Frames lost because the reader fell behind
+
+        static const char* getStageName(int stage) noexcept;
+    };
+
+    // Single-producer, single-consumer ring of telemetry frames. The audio thread pushes at
+    // most one frame per block and never waits: when the reader has fallen behind, the frame
+    // is dropped and counted instead. The reader drains whatever is ready on its own schedule.
+    class TelemetryChannel
+    {
+    public:
+        explicit TelemetryChannel(int capacity = 1024);
+
+        // Nothing is measured or pushed until a reader asks for it
+        void setEnabled(bool shouldBeEnabled) noexcept      { enabled = shouldBeEnabled; }
+        bool isEnabled() const noexcept                     { return enabled.load(std::memory_order_relaxed); }
+
+        // Audio thread only
+        void push(TelemetryFrame frame) noexcept;
+
+        // Reader thread only; copies out up to maxFrames and returns how many
+        int pop(TelemetryFrame* destination, int maxFrames) noexcept;
+
+        // Distinguishes plugin instances in the UI and in logs
+        int getInstanceId() const noexcept                  { return instanceId; }
+
+    private:
+        juce::AbstractFifo fifo;
+        std::vector<TelemetryFrame> frames;
+        std::atomic<bool> enabled { false };
+        juce::uint32 droppedFrames = 0;
+        const int instanceId;
+    };
+}
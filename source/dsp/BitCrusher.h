@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Lanes.h"
+
+namespace riser
+{
+    // Bit depth reduction with optional sample-rate reduction (sample-and-hold) and first-order
+    // antiderivative anti-aliasing. Works on whole blocks of VectorType, so with a SIMDRegister
+    // every channel packed into the register is crushed by the same instructions.
+    //
+    // The quantiser is Q(x) = step * floor(x / step + 0.5). Its antiderivative in step units is
+    // G(u) = k*u - k*k/2 with k = floor(u + 0.5), and the ADAA output is the mean of Q between
+    // consecutive inputs, (G(u) - G(u1)) / (u - u1). That is rewritten as
+    //     k + (k - k1) * (u1 - (k + k1) / 2) / (u - u1)
+    // which is exact when both inputs fall on the same step and stays well conditioned when a
+    // step boundary is crossed by a tiny interval, so no separate ill-conditioned branch is needed.
+    template <typename VectorType>
+    class BitCrusher
+    {
+    public:
+        using Element = typename Lanes<VectorType>::Element;
+
+        void reset() noexcept
+        {
+            previousInput = Lanes<VectorType>::expand(0);
+            heldSample = Lanes<VectorType>::expand(0);
+            holdPhase = holdFactor;
+        }
+
+        // Depths of 24 bits or more leave the signal unquantised
+        void setBitDepth(Element newBitDepth) noexcept
+        {
+            if (newBitDepth == bitDepth)
+                return;
+
+            bitDepth = newBitDepth;
+            const auto levels = std::exp2(bitDepth);
+            step = Element(2) / levels;
+            inverseStep = levels / Element(2);
+        }
+
+        // Holds each input sample for this many output samples; fractional factors are allowed
+        void setDownsampleFactor(Element newFactor) noexcept
+        {
+            holdFactor = juce::jmax(Element(1), newFactor);
+            holdPhase = juce::jmin(holdPhase, holdFactor);
+        }
+
+        void setAntialiasing(bool shouldAntialias) noexcept   { antialias = shouldAntialias; }
+
+        void process(VectorType* data, size_t numSamples) noexcept
+        {
+            if (holdFactor > Element(1))
+                sampleAndHold(data, numSamples);
+
+            if (bitDepth >= Element(24)) {
+                if (numSamples > 0)
+                    previousInput = data[numSamples - 1];
+                return;
+            }
+
+            if (antialias)
+                quantiseAntialiased(data, numSamples);
+            else
+                quantise(data, numSamples);
+        }
+
+    private:
+        void sampleAndHold(VectorType* data, size_t numSamples) noexcept
+        {
+            for (size_t i = 0; i < numSamples; ++i) {
+                holdPhase += Element(1);
+
+                if (holdPhase >= holdFactor) {
+                    holdPhase -= holdFactor;
+                    heldSample = data[i];
+                }
+
+                data[i] = heldSample;
+            }
+        }
+
+        // Scales to step units, clamped so Lanes::floor stays inside the int32 range
+        VectorType toSteps(VectorType sample) const noexcept
+        {
+            const auto scaled = sample * inverseStep;
+            return Lanes<VectorType>::max(Lanes<VectorType>::expand(-maxSteps),
+                                          Lanes<VectorType>::min(Lanes<VectorType>::expand(maxSteps), scaled));
+        }
+
+        void quantise(VectorType* data, size_t numSamples) noexcept
+        {
+            const auto half = Lanes<VectorType>::expand(Element(0.5));
+
+            if (numSamples > 0)
+                previousInput = data[numSamples - 1];
+
+            for (size_t i = 0; i < numSamples; ++i)
+                data[i] = Lanes<VectorType>::floor(toSteps(data[i]) + half) * step;
+        }
+
+        void quantiseAntialiased(VectorType* data, size_t numSamples) noexcept
+        {
+            const auto half = Lanes<VectorType>::expand(Element(0.5));
+            auto previousSteps = toSteps(previousInput);
+            auto previousLevel = Lanes<VectorType>::floor(previousSteps + half);
+
+            for (size_t i = 0; i < numSamples; ++i) {
+                const auto input = data[i];
+                const auto steps = toSteps(input);
+                const auto level = Lanes<VectorType>::floor(steps + half);
+
+                const auto numerator = (level - previousLevel) * (previousSteps - (level + previousLevel) * half);
+                const auto mean = level + Lanes<VectorType>::divide(numerator, Lanes<VectorType>::oneIfZero(steps - previousSteps));
+
+                // The mean of Q over the interval always lies between the two end levels
+                const auto lowest = Lanes<VectorType>::min(level, previousLevel);
+                const auto highest = Lanes<VectorType>::max(level, previousLevel);
+                data[i] = Lanes<VectorType>::max(lowest, Lanes<VectorType>::min(highest, mean)) * step;
+
+                previousInput = input;
+                previousSteps = steps;
+                previousLevel = level;
+            }
+        }
+
+        static constexpr Element maxSteps = Element(1 << 30);
+
+        Element bitDepth = 24, step = 0, inverseStep = 1;
+        Element holdFactor = 1, holdPhase = 1;
+        bool antialias = true;
+        VectorType previousInput = Lanes<VectorType>::expand(0);
+        VectorType heldSample = Lanes<VectorType>::expand(0);
+    };
+}
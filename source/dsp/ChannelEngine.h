@@ -0,0 +1,256 @@
+#pragma once
+
+#include "BitCrusher.h"
+#include "FeedbackDelay.h"
+#include "TransientShaper.h"
+
+namespace riser
+{
+    // Runs the point-wise and filter stages of the riser chain on channels packed into the
+    // lanes of VectorType. With juce::dsp::SIMDRegister<float> a stereo pair shares one
+    // register, so every stage walks the block once for both channels instead of once per
+    // channel. With a plain float each channel gets its own lane group, which is the scalar
+    // fallback; both produce the same output because they run the same code per lane.
+    //
+    // A lane group holds channels, never consecutive samples: every stage carries state from
+    // one sample to the next. So a stereo float bus leaves two of SSE's four lanes idle, and
+    // the interleaving costs a copy in and out per call. MiniRiserBenchmark --engine measures
+    // what is left of the gain per channel count.
+    template <typename VectorType>
+    class ChannelEngine
+    {
+    public:
+        using Element = typename Lanes<VectorType>::Element;
+        using CoefficientsPtr = typename juce::dsp::IIR::Coefficients<Element>::Ptr;
+        static constexpr size_t numLanes = Lanes<VectorType>::count;
+
+        struct Parameters {
+            Element transientAttack = 0;
+            Element transientSustain = 0;
+            Element bitDepth = 24;
+            Element downsampleFactor = 1;
+            bool antialias = true;
+        };
+
+        void prepare(const juce::dsp::ProcessSpec& spec, CoefficientsPtr highPassCoefficients, int maxDelaySamples, int lookaheadSamples)
+        {
+            sampleRate = spec.sampleRate;
+            numChannels = static_cast<size_t>(spec.numChannels);
+            const auto numGroups = (numChannels + numLanes - 1) / numLanes;
+
+            groups.clear();
+            for (size_t i = 0; i < numGroups; ++i) {
+                auto* group = groups.add(new Group());
+                group->highPass.coefficients = highPassCoefficients;
+                group->highPass.prepare({ spec.sampleRate, spec.maximumBlockSize, 1 });
+                group->shaper.prepare(spec.sampleRate, lookaheadSamples);
+                group->crusher.reset();
+                group->delay.prepare(maxDelaySamples);
+            }
+
+            packed = juce::dsp::AudioBlock<VectorType>(packedData, 1, spec.maximumBlockSize);
+        }
+
+        void reset()
+        {
+            for (auto* group : groups) {
+                group->highPass.reset();
+                group->shaper.reset();
+                group->crusher.reset();
+                group->delay.reset();
+            }
+        }
+
+        // Rebuilds the transient shaper's lookahead delay; allocates, so not on the audio thread
+        void setLookahead(int lookaheadSamples)
+        {
+            for (auto* group : groups)
+                group->shaper.prepare(sampleRate, lookaheadSamples);
+        }
+
+        int getLatencySamples() const noexcept
+        {
+            return groups.isEmpty() ? 0 : groups.getFirst()->shaper.getLatencySamples();
+        }
+
+        // High-pass, transient shaper, bit crush and pan in a single pass. The pan gains are given
+        // per channel at the start and end of the block and ramped linearly in between; null
+        // means unity.
+        void processPreReverb(const juce::dsp::AudioBlock<Element>& block, const Parameters& parameters,
+                              const Element* panGainsStart, const Element* panGainsEnd)
+        {
+            forEachGroup(block, [&](Group& group, size_t groupIndex, VectorType* data, size_t numSamples) {
+                filter(group, data, numSamples);
+                shape(group, data, numSamples, parameters);
+                crush(group, data, numSamples, parameters, 1);
+                pan(groupIndex, data, numSamples, panGainsStart, panGainsEnd);
+            });
+        }
+
+        // The same stages split up, so the nonlinear one can run on an oversampled block. The
+        // crusher's hold time is given in base-rate samples and scaled by holdScale.
+        void processFilter(const juce::dsp::AudioBlock<Element>& block)
+        {
+            forEachGroup(block, [&](Group& group, size_t, VectorType* data, size_t numSamples) {
+                filter(group, data, numSamples);
+            });
+        }
+
+        void processTransients(const juce::dsp::AudioBlock<Element>& block, const Parameters& parameters)
+        {
+            forEachGroup(block, [&](Group& group, size_t, VectorType* data, size_t numSamples) {
+                shape(group, data, numSamples, parameters);
+            });
+        }
+
+        void processCrusher(const juce::dsp::AudioBlock<Element>& block, const Parameters& parameters, Element holdScale)
+        {
+            forEachGroup(block, [&](Group& group, size_t, VectorType* data, size_t numSamples) {
+                crush(group, data, numSamples, parameters, holdScale);
+            });
+        }
+
+        void processPan(const juce::dsp::AudioBlock<Element>& block, const Element* panGainsStart, const Element* panGainsEnd)
+        {
+            if (panGainsStart == nullptr)
+                return;
+
+            forEachGroup(block, [&](Group&, size_t groupIndex, VectorType* data, size_t numSamples) {
+                pan(groupIndex, data, numSamples, panGainsStart, panGainsEnd);
+            });
+        }
+
+        // Feedback delay with per-sample wet and feedback levels shared by all channels, then
+        // the output gain, in a single pass. The delay time in samples ramps from delayStart to
+        // delayEnd across the block and the gain from gainStart to gainEnd.
+        void processPostReverb(const juce::dsp::AudioBlock<Element>& block, const Element* wetLevels,
+                               const Element* feedbackLevels, Element delayStart, Element delayEnd,
+                               Element gainStart, Element gainEnd)
+        {
+            forEachGroup(block, [&](Group& group, size_t, VectorType* data, size_t numSamples) {
+                group.delay.process(data, numSamples, wetLevels, feedbackLevels, delayStart, delayEnd);
+                applyGain(data, numSamples, gainStart, gainEnd);
+            });
+        }
+
+    private:
+        struct Group {
+            juce::dsp::IIR::Filter<VectorType> highPass;
+            TransientShaper<VectorType> shaper;
+            BitCrusher<VectorType> crusher;
+            FeedbackDelay<VectorType> delay;
+        };
+
+        template <typename Function>
+        void forEachGroup(const juce::dsp::AudioBlock<Element>& block, Function&& function)
+        {
+            const auto numSamples = block.getNumSamples();
+
+            for (size_t groupIndex = 0; groupIndex < static_cast<size_t>(groups.size()); ++groupIndex) {
+                auto packedBlock = pack(block, groupIndex);
+                function(*groups.getUnchecked(static_cast<int>(groupIndex)), groupIndex, packedBlock.getChannelPointer(0), numSamples);
+                unpack(block, groupIndex);
+            }
+        }
+
+        void filter(Group& group, VectorType* data, size_t numSamples)
+        {
+            juce::dsp::AudioBlock<VectorType> packedBlock(&data, 1, numSamples);
+            juce::dsp::ProcessContextReplacing<VectorType> context(packedBlock);
+            group.highPass.process(context);
+        }
+
+        void shape(Group& group, VectorType* data, size_t numSamples, const Parameters& parameters)
+        {
+            group.shaper.process(data, numSamples, parameters.transientAttack, parameters.transientSustain);
+        }
+
+        void crush(Group& group, VectorType* data, size_t numSamples, const Parameters& parameters, Element holdScale)
+        {
+            group.crusher.setBitDepth(parameters.bitDepth);
+            group.crusher.setDownsampleFactor(parameters.downsampleFactor * holdScale);
+            group.crusher.setAntialiasing(parameters.antialias);
+            group.crusher.process(data, numSamples);
+        }
+
+        void pan(size_t groupIndex, VectorType* data, size_t numSamples, const Element* panGainsStart, const Element* panGainsEnd)
+        {
+            if (panGainsStart == nullptr || numSamples == 0)
+                return;
+
+            const auto firstChannel = groupIndex * numLanes;
+            auto gain = Lanes<VectorType>::expand(1);
+            auto increment = Lanes<VectorType>::expand(0);
+
+            for (size_t lane = 0; lane < numLanes && firstChannel + lane < numChannels; ++lane) {
+                const auto channel = firstChannel + lane;
+                Lanes<VectorType>::set(gain, lane, panGainsStart[channel]);
+                Lanes<VectorType>::set(increment, lane, (panGainsEnd[channel] - panGainsStart[channel]) / static_cast<Element>(numSamples));
+            }
+
+            for (size_t i = 0; i < numSamples; ++i) {
+                gain += increment;
+                data[i] *= gain;
+            }
+        }
+
+        // The ramp reaches gainEnd on the last sample, like pan
+        static void applyGain(VectorType* data, size_t numSamples, Element gainStart, Element gainEnd) noexcept
+        {
+            if ((gainStart == Element(1) && gainEnd == Element(1)) || numSamples == 0)
+                return;
+
+            auto gain = Lanes<VectorType>::expand(gainStart);
+            const auto increment = Lanes<VectorType>::expand((gainEnd - gainStart) / static_cast<Element>(numSamples));
+
+            for (size_t i = 0; i < numSamples; ++i) {
+                gain += increment;
+                data[i] *= gain;
+            }
+        }
+
+        // Interleaves the channels of one lane group into the packed scratch block. Lanes past
+        // the last channel are zeroed so they stay denormal-free and never reach the output.
+        juce::dsp::AudioBlock<VectorType> pack(const juce::dsp::AudioBlock<Element>& block, size_t groupIndex)
+        {
+            const auto numSamples = block.getNumSamples();
+            const auto firstChannel = groupIndex * numLanes;
+            auto packedBlock = packed.getSubBlock(0, numSamples);
+            auto* raw = reinterpret_cast<Element*>(packedBlock.getChannelPointer(0));
+
+            for (size_t lane = 0; lane < numLanes; ++lane) {
+                const auto channel = firstChannel + lane;
+
+                if (channel < block.getNumChannels()) {
+                    const auto* source = block.getChannelPointer(channel);
+                    for (size_t i = 0; i < numSamples; ++i)
+                        raw[i * numLanes + lane] = source[i];
+                } else {
+                    for (size_t i = 0; i < numSamples; ++i)
+                        raw[i * numLanes + lane] = Element(0);
+                }
+            }
+
+            return packedBlock;
+        }
+
+        void unpack(const juce::dsp::AudioBlock<Element>& block, size_t groupIndex) const
+        {
+            const auto numSamples = block.getNumSamples();
+            const auto firstChannel = groupIndex * numLanes;
+            const auto* raw = reinterpret_cast<const Element*>(packed.getChannelPointer(0));
+
+            for (size_t lane = 0; lane < numLanes && firstChannel + lane < block.getNumChannels(); ++lane) {
+                auto* destination = block.getChannelPointer(firstChannel + lane);
+                for (size_t i = 0; i < numSamples; ++i)
+                    destination[i] = raw[i * numLanes + lane];
+            }
+        }
+
+        juce::OwnedArray<Group> groups;
+        juce::HeapBlock<char> packedData;
+        juce::dsp::AudioBlock<VectorType> packed;
+        size_t numChannels = 0;
+        double sampleRate = 44100.0;
+    };
+}
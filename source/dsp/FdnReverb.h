@@ -0,0 +1,236 @@
+#pragma once
+
+#include "Lanes.h"
+
+namespace riser
+{
+    // Multichannel reverb built on an eight-line feedback delay network. The line outputs are
+    // packed into VectorType lanes, so damping, the decay gains and the Householder feedback
+    // matrix run as vector operations across all lines; only the delay taps are gathered one
+    // line at a time. One instance serves every channel of the bus: each channel feeds and
+    // reads its own subset of lines (alternate lines for stereo) and the feedback matrix
+    // cross-couples them, which is where the tail gets its width.
+    //
+    // All lines share one power-of-two ring of frames, so a sample's write is a single frame
+    // store and every read is a masked offset from the same write position.
+    template <typename VectorType>
+    class FdnReverb
+    {
+    public:
+        using Element = typename Lanes<VectorType>::Element;
+        static constexpr size_t numLines = 8;
+        static constexpr size_t numLanes = Lanes<VectorType>::count;
+        static constexpr size_t numVectors = numLines / numLanes;
+        static_assert(numLines % numLanes == 0, "The network's lines must fill whole registers");
+
+        struct Parameters {
+            Element decaySeconds = Element(2.5);    // RT60 of the undamped network
+            Element damping = Element(0.3);         // 0 is bright, 1 is dark
+            Element wetLevel = 0;
+            Element dryLevel = 1;
+            Element width = 1;
+        };
+
+        void prepare(double newSampleRate, int newNumChannels)
+        {
+            sampleRate = newSampleRate;
+            numChannels = static_cast<size_t>(juce::jmax(1, newNumChannels));
+
+            longestLine = 1;
+            for (size_t line = 0; line < numLines; ++line) {
+                lineLengths[line] = static_cast<size_t>(juce::jmax(1, juce::roundToInt(lineMilliseconds[line] * 0.001 * sampleRate)));
+                longestLine = juce::jmax(longestLine, lineLengths[line]);
+            }
+
+            const auto size = juce::nextPowerOfTwo(static_cast<int>(longestLine) + 1);
+            ring.resize(static_cast<size_t>(size));
+            mask = static_cast<size_t>(size - 1);
+
+            channelInputs.resize(numChannels);
+            channelOutputs.resize(numChannels);
+            wetOutputs.resize(numChannels);
+
+            // Gains are scaled so every channel sends and receives the same energy as a stereo one
+            const auto linesPerChannel = static_cast<Element>(numChannels <= maxOwningChannels ? numLines / numChannels : 2);
+            const auto channelScale = std::sqrt(Element(4) / linesPerChannel);
+
+            for (size_t channel = 0; channel < numChannels; ++channel) {
+                for (size_t line = 0; line < numLines; ++line) {
+                    const auto sign = getLineSign(channel, line);
+                    Lanes<VectorType>::set(channelInputs[channel][line / numLanes], line % numLanes,
+                                           sign != 0 ? inputGain * channelScale : Element(0));
+                    Lanes<VectorType>::set(channelOutputs[channel][line / numLanes], line % numLanes,
+                                           static_cast<Element>(sign) * outputGain * channelScale);
+                }
+            }
+
+            wetGain1.reset(sampleRate, 0.01);
+            wetGain2.reset(sampleRate, 0.01);
+            dryGain.reset(sampleRate, 0.01);
+
+            updateLineFilters();
+            reset();
+        }
+
+        void reset()
+        {
+            Frame silence;
+            silence.lines.fill(Lanes<VectorType>::expand(0));
+            std::fill(ring.begin(), ring.end(), silence);
+            dampingState.fill(Lanes<VectorType>::expand(0));
+            writeIndex = 0;
+
+            wetGain1.setCurrentAndTargetValue(wetGain1.getTargetValue());
+            wetGain2.setCurrentAndTargetValue(wetGain2.getTargetValue());
+            dryGain.setCurrentAndTargetValue(dryGain.getTargetValue());
+        }
+
+        // Cheap to call every control block: the per-line filters are only recomputed when
+        // the decay or damping actually change
+        void setParameters(const Parameters& newParameters)
+        {
+            const bool filtersChanged = newParameters.decaySeconds != parameters.decaySeconds
+                                     || newParameters.damping != parameters.damping;
+            parameters = newParameters;
+
+            if (filtersChanged)
+                updateLineFilters();
+
+            wetGain1.setTargetValue(parameters.wetLevel * (parameters.width * Element(0.5) + Element(0.5)));
+            wetGain2.setTargetValue(parameters.wetLevel * (Element(1) - parameters.width) * Element(0.5));
+            dryGain.setTargetValue(parameters.dryLevel);
+        }
+
+        // The longest path through the network before anything reaches the output
+        size_t getLongestLineSamples() const noexcept           { return longestLine; }
+
+        // Processes the first getNumChannels() channels of the block in place
+        void process(const juce::dsp::AudioBlock<Element>& block) noexcept
+        {
+            if (ring.empty())
+                return;
+
+            const auto numSamples = block.getNumSamples();
+            const auto numBlockChannels = juce::jmin(numChannels, block.getNumChannels());
+            const auto reflectionScale = Element(2) / static_cast<Element>(numLines);
+
+            for (size_t i = 0; i < numSamples; ++i) {
+                std::array<VectorType, numVectors> taps;
+
+                for (size_t line = 0; line < numLines; ++line) {
+                    const auto& frame = ring[(writeIndex - lineLengths[line]) & mask];
+                    Lanes<VectorType>::set(taps[line / numLanes], line % numLanes,
+                                           Lanes<VectorType>::get(frame.lines[line / numLanes], line % numLanes));
+                }
+
+                // One-pole lowpass and decay gain per line, then the Householder reflection
+                // x - (2 / N) * sum(x), which is lossless and mixes every line into every other
+                std::array<VectorType, numVectors> feedback;
+                Element feedbackSum = 0;
+
+                for (size_t v = 0; v < numVectors; ++v) {
+                    dampingState[v] = taps[v] + (dampingState[v] - taps[v]) * dampingCoefficient;
+                    feedback[v] = dampingState[v] * lineGains[v];
+                    feedbackSum += Lanes<VectorType>::sum(feedback[v]);
+                }
+
+                const auto reflection = Lanes<VectorType>::expand(feedbackSum * reflectionScale);
+                auto& frame = ring[writeIndex];
+
+                for (size_t v = 0; v < numVectors; ++v)
+                    frame.lines[v] = feedback[v] - reflection;
+
+                for (size_t channel = 0; channel < numBlockChannels; ++channel) {
+                    const auto input = block.getSample(static_cast<int>(channel), static_cast<int>(i));
+                    Element wet = 0;
+
+                    for (size_t v = 0; v < numVectors; ++v) {
+                        frame.lines[v] += channelInputs[channel][v] * input;
+                        wet += Lanes<VectorType>::sum(taps[v] * channelOutputs[channel][v]);
+                    }
+
+                    wetOutputs[channel] = wet;
+                }
+
+                writeIndex = (writeIndex + 1) & mask;
+
+                // Width blends each channel with its neighbour in the pair (left/right for stereo)
+                const auto wet1 = wetGain1.getNextValue();
+                const auto wet2 = wetGain2.getNextValue();
+                const auto dry = dryGain.getNextValue();
+
+                for (size_t channel = 0; channel < numBlockChannels; ++channel) {
+                    const auto partner = (channel ^ 1) < numBlockChannels ? (channel ^ 1) : channel;
+                    auto* data = block.getChannelPointer(channel);
+                    data[i] = wetOutputs[channel] * wet1 + wetOutputs[partner] * wet2 + data[i] * dry;
+                }
+            }
+        }
+
+    private:
+        struct Frame {
+            std::array<VectorType, numVectors> lines;
+        };
+
+        // Up to four channels each own the lines congruent to them modulo the channel count,
+        // alternating the output sign. Wider buses give every channel a pair of lines, one
+        // from each half of the network, with the pairing rotated every four channels and the
+        // second line's sign flipped on alternate rounds; up to 16 channels, no two channels
+        // read the same lines, so no two share a tail.
+        int getLineSign(size_t channel, size_t line) const noexcept
+        {
+            if (numChannels <= maxOwningChannels) {
+                if (line % numChannels != channel % numChannels)
+                    return 0;
+                return (line / numChannels) % 2 == 0 ? 1 : -1;
+            }
+
+            const auto round = channel / 4;
+            const auto first = channel % 4;
+            const auto second = numLines / 2 + (first + round) % 4;
+
+            if (line == first)
+                return 1;
+            if (line == second)
+                return round % 2 == 0 ? 1 : -1;
+            return 0;
+        }
+
+        static constexpr size_t maxOwningChannels = 4;
+
+        // Each line's gain gives the same 60 dB decay time regardless of its length
+        void updateLineFilters()
+        {
+            for (size_t line = 0; line < numLines; ++line) {
+                const auto lineSeconds = static_cast<double>(lineLengths[line]) / sampleRate;
+                const auto decaySeconds = juce::jmax(0.01, static_cast<double>(parameters.decaySeconds));
+                const auto gain = std::pow(10.0, -3.0 * lineSeconds / decaySeconds);
+                Lanes<VectorType>::set(lineGains[line / numLanes], line % numLanes, static_cast<Element>(gain));
+            }
+
+            dampingCoefficient = juce::jlimit(Element(0), Element(0.95), parameters.damping * Element(0.4));
+        }
+
+        // Mutually prime-ish lengths spread between roughly 30 and 75 ms
+        static constexpr double lineMilliseconds[numLines] = { 31.7, 37.3, 41.9, 45.1, 53.9, 59.3, 67.9, 73.3 };
+        static constexpr Element inputGain = Element(0.5);
+        static constexpr Element outputGain = Element(0.5);
+
+        Parameters parameters;
+        double sampleRate = 44100.0;
+
+        std::vector<Frame> ring;
+        size_t mask = 0, writeIndex = 0, longestLine = 1;
+        std::array<size_t, numLines> lineLengths {};
+
+        std::array<VectorType, numVectors> lineGains, dampingState;
+
+        // Per-channel injection and output weights across the lines, and the per-sample wet mix
+        size_t numChannels = 2;
+        std::vector<std::array<VectorType, numVectors>> channelInputs, channelOutputs;
+        std::vector<Element> wetOutputs;
+        Element dampingCoefficient = 0;
+
+        juce::SmoothedValue<Element> wetGain1, wetGain2, dryGain;
+    };
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Lanes.h"
+
+namespace riser
+{
+    // Feedback delay on a power-of-two ring buffer sized from the longest delay it has to
+    // hold, so every wrap is a mask rather than a modulo. Writes walk the block in contiguous
+    // spans between wrap points; reads are linearly interpolated so fractional, tempo-synced
+    // delay times can glide from one value to the next without clicks.
+    template <typename VectorType>
+    class FeedbackDelay
+    {
+    public:
+        using Element = typename Lanes<VectorType>::Element;
+
+        void prepare(int maxDelaySamples)
+        {
+            // Two spare slots: one for the interpolation's second tap, one for the write
+            const auto size = juce::nextPowerOfTwo(juce::jmax(1, maxDelaySamples) + 2);
+            buffer.assign(static_cast<size_t>(size), Lanes<VectorType>::expand(0));
+            mask = size - 1;
+            maxDelay = static_cast<Element>(juce::jmax(1, maxDelaySamples));
+            writeIndex = 0;
+        }
+
+        void reset() noexcept
+        {
+            std::fill(buffer.begin(), buffer.end(), Lanes<VectorType>::expand(0));
+            writeIndex = 0;
+        }
+
+        size_t getBufferSize() const noexcept                 { return buffer.size(); }
+
+        // Mixes the delayed signal into data with per-sample wet and feedback levels. The delay
+        // time, in samples, moves linearly from delayStart to delayEnd across the block.
+        void process(VectorType* data, size_t numSamples, const Element* wetLevels,
+                     const Element* feedbackLevels, Element delayStart, Element delayEnd) noexcept
+        {
+            if (numSamples == 0 || buffer.empty())
+                return;
+
+            auto delay = clampDelay(delayStart);
+            const auto delayIncrement = (clampDelay(delayEnd) - delay) / static_cast<Element>(numSamples);
+            auto* ring = buffer.data();
+
+            for (size_t done = 0; done < numSamples;) {
+                const auto spanLength = juce::jmin(numSamples - done, buffer.size() - writeIndex);
+
+                for (size_t i = 0; i < spanLength; ++i) {
+                    delay += delayIncrement;
+
+                    const auto readPosition = static_cast<Element>(writeIndex + i) - delay;
+                    const auto wholePosition = std::floor(readPosition);
+                    const auto fraction = readPosition - wholePosition;
+                    const auto index = static_cast<size_t>(static_cast<int>(wholePosition) & mask);
+                    const auto nextIndex = (index + 1) & static_cast<size_t>(mask);
+                    const auto delayedSample = ring[index] + (ring[nextIndex] - ring[index]) * fraction;
+
+                    const auto sample = done + i;
+                    const auto input = data[sample];
+                    data[sample] = input * (Element(1) - wetLevels[sample]) + delayedSample * wetLevels[sample];
+                    ring[writeIndex + i] = input + delayedSample * feedbackLevels[sample];
+                }
+
+                done += spanLength;
+                writeIndex = (writeIndex + spanLength) & static_cast<size_t>(mask);
+            }
+        }
+
+    private:
+        // At least one sample, so a read never lands on the slot being written
+        Element clampDelay(Element delay) const noexcept      { return juce::jlimit(Element(1), maxDelay, delay); }
+
+        std::vector<VectorType> buffer;
+        int mask = 0;
+        Element maxDelay = 1;
+        size_t writeIndex = 0;
+    };
+}
@@ -0,0 +1,146 @@
+#include "ImpactMapping.h"
+
+namespace riser
+{
+    namespace
+    {
+        struct TargetInfo {
+            const char* name;
+            float minimum, maximum;
+        };
+
+        // Order matches ImpactMapping::Target
+        constexpr TargetInfo targetInfo[] = {
+            { "highPassCutoff",   10.0f,  20000.0f },
+            { "transientAttack",  -1.0f,  1.0f },
+            { "transientSustain", -1.0f,  1.0f },
+            { "bitDepth",         1.0f,   24.0f },
+            { "downsampleFactor", 1.0f,   64.0f },
+            { "reverbWet",        0.0f,   1.0f },
+            { "delayWet",         0.0f,   1.0f },
+            { "delayFeedback",    0.0f,   0.95f },
+            { "panDepth",         0.0f,   1.0f },
+            { "makeupGain",       -24.0f, 24.0f },
+        };
+
+        static_assert(std::size(targetInfo) == ImpactMapping::numTargets, "Every target needs its info");
+    }
+
+    ImpactMapping::ImpactMapping()
+    {
+        resetToDefaults();
+        active = compiled;
+        pendingChanged = false;
+    }
+
+    const char* ImpactMapping::getTargetName(Target target) noexcept
+    {
+        return targetInfo[static_cast<size_t>(target)].name;
+    }
+
+    ImpactMapping::Curve ImpactMapping::getDefaultCurve(Target target)
+    {
+        switch (target) {
+            case highPassCutoff:    return { { 0.0f, 20.0f }, { 1.0f, 1500.0f } };
+            case transientAttack:   return { { 0.0f, 0.0f }, { 1.0f, -0.5f } };
+            case transientSustain:  return { { 0.0f, 0.0f }, { 1.0f, 0.5f } };
+            case bitDepth:          return { { 0.0f, 24.0f }, { 1.0f, 6.0f } };
+            case downsampleFactor:  return { { 0.0f, 1.0f }, { 1.0f, 8.0f } };
+            case reverbWet:         return { { 0.0f, 0.0f }, { 1.0f, 0.5f } };
+            case delayWet:          return { { 0.0f, 0.0f }, { 1.0f, 0.4f } };
+            case delayFeedback:     return { { 0.0f, 0.0f }, { 1.0f, 0.75f } };
+            case panDepth:          return { { 0.0f, 0.0f }, { 0.8f, 0.8f }, { 1.0f, 0.8f } };
+
+            // Flat up to a quarter of the way, then up to +10 dB along a line that starts at 20%
+            case makeupGain:        return { { 0.0f, 0.0f }, { 0.25f, 0.0f }, { 0.25f, 10.0f / 15.0f }, { 0.95f, 10.0f }, { 1.0f, 10.0f } };
+
+            case numTargets:        break;
+        }
+
+        return {};
+    }
+
+    void ImpactMapping::setCurve(Target target, Curve newCurve)
+    {
+        const auto& info = targetInfo[static_cast<size_t>(target)];
+
+        for (auto& point : newCurve) {
+            point.x = juce::jlimit(0.0f, 1.0f, point.x);
+            point.y = juce::jlimit(info.minimum, info.maximum, point.y);
+        }
+
+        std::stable_sort(newCurve.begin(), newCurve.end(), [](const Point& a, const Point& b) { return a.x < b.x; });
+
+        if (newCurve.empty())
+            newCurve = getDefaultCurve(target);
+
+        curves[static_cast<size_t>(target)] = std::move(newCurve);
+        compile(target);
+        publish();
+    }
+
+    void ImpactMapping::resetToDefaults()
+    {
+        for (int target = 0; target < numTargets; ++target) {
+            curves[static_cast<size_t>(target)] = getDefaultCurve(static_cast<Target>(target));
+            compile(static_cast<Target>(target));
+        }
+
+        publish();
+    }
+
+    bool ImpactMapping::update() noexcept
+    {
+        if (! pendingChanged.load(std::memory_order_acquire))
+            return false;
+
+        const juce::SpinLock::ScopedTryLockType lock(pendingLock);
+        if (! lock.isLocked())
+            return false;
+
+        active = pending;
+        pendingChanged = false;
+        return true;
+    }
+
+    void ImpactMapping::compile(Target target)
+    {
+        const auto& curve = curves[static_cast<size_t>(target)];
+        auto& table = compiled[static_cast<size_t>(target)];
+
+        for (int i = 0; i < tableSize; ++i) {
+            const auto x = static_cast<float>(i) / static_cast<float>(tableSize - 1);
+
+            // The last segment that starts at or before x; zero-width segments are steps
+            auto value = curve.front().y;
+            for (size_t segment = 1; segment < curve.size(); ++segment) {
+                const auto& start = curve[segment - 1];
+                const auto& end = curve[segment];
+
+                if (x < start.x)
+                    break;
+
+                if (x >= end.x) {
+                    value = end.y;
+                    continue;
+                }
+
+                const auto t = (x - start.x) / (end.x - start.x);
+                const auto shaped = end.tension == 0.0f ? t : std::pow(t, std::exp2(end.tension));
+                value = start.y + (end.y - start.y) * shaped;
+                break;
+            }
+
+            table[static_cast<size_t>(i)] = target == makeupGain ? juce::Decibels::decibelsToGain(value) : value;
+        }
+
+        maxima[static_cast<size_t>(target)] = *std::max_element(table.begin(), table.end());
+    }
+
+    void ImpactMapping::publish() noexcept
+    {
+        const juce::SpinLock::ScopedLockType lock(pendingLock);
+        pending = compiled;
+        pendingChanged.store(true, std::memory_order_release);
+    }
+}
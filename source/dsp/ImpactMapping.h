@@ -0,0 +1,79 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace riser
+{
+    // How the normalised Impact value drives each stage of the chain. Every target has an
+    // editable breakpoint curve in its own units, which is compiled into a small lookup table;
+    // the audio thread only ever reads tables, so mapping Impact costs one interpolated table
+    // read per target and control block, whatever shape the curves have.
+    //
+    // Curves are edited on the message thread. Compiled tables are handed to the audio thread
+    // through a pending copy that it picks up with a try-lock, so it never waits on an edit.
+    class ImpactMapping
+    {
+    public:
+        enum Target {
+            highPassCutoff,         // Hz
+            transientAttack,        // -1 softens onsets fully, +1 doubles them
+            transientSustain,       // -1 to +1, the same for the decay
+            bitDepth,               // bits
+            downsampleFactor,       // hold length in samples, used in "Bits + Rate" mode
+            reverbWet,              // 0 to 1; dry is 1 - wet
+            delayWet,               // 0 to 1
+            delayFeedback,          // 0 to 0.95
+            panDepth,               // 0 to 1
+            makeupGain,             // authored in dB, compiled to linear gain
+            numTargets
+        };
+
+        // tension bends the segment that ends at this point: 0 is straight, positive values
+        // start slow and finish fast, negative values the opposite. Points may share an x to
+        // make a step.
+        struct Point {
+            float x = 0.0f, y = 0.0f, tension = 0.0f;
+        };
+        using Curve = std::vector<Point>;
+
+        static constexpr int tableSize = 129;
+
+        ImpactMapping();
+
+        static const char* getTargetName(Target target) noexcept;
+        static Curve getDefaultCurve(Target target);
+
+        // Message thread
+        const Curve& getCurve(Target target) const noexcept         { return curves[static_cast<size_t>(target)]; }
+        void setCurve(Target target, Curve newCurve);
+        void resetToDefaults();
+
+        // Largest value the curve can produce, in compiled units; safe from any thread
+        float getMaximum(Target target) const noexcept              { return maxima[static_cast<size_t>(target)].load(); }
+
+        // Audio thread: adopts the most recently published tables. Returns true if they changed.
+        bool update() noexcept;
+
+        float evaluate(Target target, float normalisedImpact) const noexcept
+        {
+            const auto& table = active[static_cast<size_t>(target)];
+            const auto position = juce::jlimit(0.0f, 1.0f, normalisedImpact) * static_cast<float>(tableSize - 1);
+            const auto index = juce::jmin(static_cast<int>(position), tableSize - 2);
+            const auto fraction = position - static_cast<float>(index);
+            return table[static_cast<size_t>(index)] + (table[static_cast<size_t>(index) + 1] - table[static_cast<size_t>(index)]) * fraction;
+        }
+
+    private:
+        using Table = std::array<float, tableSize>;
+
+        void compile(Target target);
+        void publish() noexcept;
+
+        std::array<Curve, numTargets> curves;
+        std::array<std::atomic<float>, numTargets> maxima;
+        std::array<Table, numTargets> compiled {}, pending {}, active {};
+
+        juce::SpinLock pendingLock;
+        std::atomic<bool> pendingChanged { false };
+    };
+}
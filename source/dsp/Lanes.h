@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace riser
+{
+    // Uniform access to plain sample types and juce::dsp::SIMDRegister, so a stage can be
+    // written once and run either on one channel at a time or on several channels packed
+    // into the lanes of one register.
+    template <typename VectorType>
+    struct Lanes
+    {
+        using Element = VectorType;
+        static constexpr size_t count = 1;
+
+        static VectorType expand(Element value) noexcept { return value; }
+        static Element get(const VectorType& value, size_t) noexcept { return value; }
+        static void set(VectorType& value, size_t, Element newValue) noexcept { value = newValue; }
+
+        static VectorType floor(VectorType value) noexcept { return std::floor(value); }
+        static VectorType abs(VectorType value) noexcept { return std::abs(value); }
+        static VectorType min(VectorType a, VectorType b) noexcept { return juce::jmin(a, b); }
+        static VectorType max(VectorType a, VectorType b) noexcept { return juce::jmax(a, b); }
+        static VectorType divide(VectorType a, VectorType b) noexcept { return a / b; }
+        static VectorType oneIfZero(VectorType value) noexcept { return value == VectorType(0) ? VectorType(1) : value; }
+        static Element sum(VectorType value) noexcept { return value; }
+    };
+
+    template <typename ElementType>
+    struct Lanes<juce::dsp::SIMDRegister<ElementType>>
+    {
+        using VectorType = juce::dsp::SIMDRegister<ElementType>;
+        using Element = ElementType;
+        static constexpr size_t count = VectorType::size();
+
+        static VectorType expand(Element value) noexcept { return VectorType::expand(value); }
+        static Element get(const VectorType& value, size_t lane) noexcept { return value.get(lane); }
+        static void set(VectorType& value, size_t lane, Element newValue) noexcept { value.set(lane, newValue); }
+
+        // SIMDRegister has no floor: truncate, then step down the lanes that truncation rounded up.
+        // Only valid while |value| fits in an int32, which callers guarantee by clamping.
+        static VectorType floor(VectorType value) noexcept
+        {
+            const auto truncated = VectorType::truncate(value);
+            return truncated - (VectorType::expand(Element(1)) & VectorType::greaterThan(truncated, value));
+        }
+
+        static VectorType abs(VectorType value) noexcept { return VectorType::abs(value); }
+        static VectorType min(VectorType a, VectorType b) noexcept { return VectorType::min(a, b); }
+        static VectorType max(VectorType a, VectorType b) noexcept { return VectorType::max(a, b); }
+
+        // SIMDRegister has no divide either, so this falls back to one division per lane
+        static VectorType divide(VectorType a, VectorType b) noexcept
+        {
+            VectorType result;
+            for (size_t lane = 0; lane < count; ++lane)
+                result.set(lane, a.get(lane) / b.get(lane));
+            return result;
+        }
+
+        static VectorType oneIfZero(VectorType value) noexcept
+        {
+            const auto zero = VectorType::expand(Element(0));
+            return value + (VectorType::expand(Element(1)) & VectorType::equal(value, zero));
+        }
+
+        static Element sum(VectorType value) noexcept { return value.sum(); }
+    };
+}
@@ -0,0 +1,152 @@
+#include "ModulationEngine.h"
+
+namespace riser
+{
+    void Lfo::setSampleRate(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        updateIncrement();
+    }
+
+    void Lfo::setFrequency(double newFrequencyHz)
+    {
+        if (newFrequencyHz != frequency || isTempoSynced()) {
+            frequency = newFrequencyHz;
+            beatsPerCycle = 0.0;
+            updateIncrement();
+        }
+    }
+
+    void Lfo::setTempoSync(double newBeatsPerCycle)
+    {
+        if (newBeatsPerCycle != beatsPerCycle) {
+            beatsPerCycle = juce::jmax(0.0, newBeatsPerCycle);
+            updateIncrement();
+        }
+    }
+
+    void Lfo::setTempo(double newBpm)
+    {
+        if (newBpm > 0.0 && newBpm != tempo) {
+            tempo = newBpm;
+            updateIncrement();
+        }
+    }
+
+    void Lfo::syncToPosition(double ppqPosition)
+    {
+        if (! isTempoSynced())
+            return;
+
+        const auto cycles = ppqPosition / beatsPerCycle;
+        setPhase(cycles - std::floor(cycles));
+    }
+
+    void Lfo::reset(double startPhase)
+    {
+        setPhase(startPhase);
+    }
+
+    float Lfo::advance(int numSamples)
+    {
+        if (numSamples != rotationStepSamples) {
+            const auto angle = juce::MathConstants<double>::twoPi * cyclesPerSample * numSamples;
+            rotationCos = std::cos(angle);
+            rotationSin = std::sin(angle);
+            rotationStepSamples = numSamples;
+        }
+
+        phase += cyclesPerSample * numSamples;
+        phase -= std::floor(phase);
+
+        const auto newCos = phasorCos * rotationCos - phasorSin * rotationSin;
+        const auto newSin = phasorSin * rotationCos + phasorCos * rotationSin;
+
+        // First-order renormalisation stops the phasor's magnitude drifting over long runs
+        const auto correction = 0.5 * (3.0 - (newCos * newCos + newSin * newSin));
+        phasorCos = newCos * correction;
+        phasorSin = newSin * correction;
+
+        return getValue();
+    }
+
+    float Lfo::getValue() const noexcept
+    {
+        switch (shape) {
+            case Shape::sine:
+                return static_cast<float>(phasorSin);
+            case Shape::triangle:
+                if (phase < 0.25) return static_cast<float>(4.0 * phase);
+                if (phase < 0.75) return static_cast<float>(2.0 - 4.0 * phase);
+                return static_cast<float>(4.0 * phase - 4.0);
+            case Shape::sawUp:
+                return static_cast<float>(2.0 * phase - 1.0);
+            case Shape::square:
+                return phase < 0.5 ? 1.0f : -1.0f;
+        }
+
+        return 0.0f;
+    }
+
+    void Lfo::updateIncrement()
+    {
+        const auto cyclesPerSecond = isTempoSynced() ? tempo / (60.0 * beatsPerCycle) : frequency;
+        cyclesPerSample = sampleRate > 0.0 ? cyclesPerSecond / sampleRate : 0.0;
+        rotationStepSamples = 0;
+    }
+
+    void Lfo::setPhase(double newPhase)
+    {
+        phase = newPhase - std::floor(newPhase);
+        phasorCos = std::cos(juce::MathConstants<double>::twoPi * phase);
+        phasorSin = std::sin(juce::MathConstants<double>::twoPi * phase);
+    }
+
+    //==============================================================================
+    PanLaw::PanLaw()
+    {
+        constexpr size_t tableSize = 256;
+        const auto quarterPi = juce::MathConstants<float>::pi * 0.25f;
+
+        leftTable.initialise([quarterPi](float pan) { return std::cos((pan + 1.0f) * quarterPi); }, -1.0f, 1.0f, tableSize);
+        rightTable.initialise([quarterPi](float pan) { return std::sin((pan + 1.0f) * quarterPi); }, -1.0f, 1.0f, tableSize);
+    }
+
+    //==============================================================================
+    void ModulationEngine::prepare(double sampleRate)
+    {
+        for (auto& lfo : lfos)
+            lfo.setSampleRate(sampleRate);
+
+        reset();
+    }
+
+    void ModulationEngine::reset()
+    {
+        for (auto& lfo : lfos)
+            lfo.reset();
+
+        values.fill(0.0f);
+    }
+
+    void ModulationEngine::setHostPosition(juce::Optional<double> bpm, juce::Optional<double> ppqPosition, bool isPlaying)
+    {
+        for (auto& lfo : lfos) {
+            if (! lfo.isTempoSynced())
+                continue;
+
+            if (bpm.hasValue())
+                lfo.setTempo(*bpm);
+
+            // Only follow the transport while it runs, otherwise a stopped host would freeze the LFO
+            if (isPlaying && ppqPosition.hasValue())
+                lfo.syncToPosition(*ppqPosition);
+        }
+    }
+
+    void ModulationEngine::advance(int numSamples)
+    {
+        for (size_t i = 0; i < lfos.size(); ++i)
+            values[i] = lfos[i].advance(numSamples);
+    }
+}
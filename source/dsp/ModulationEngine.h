@@ -0,0 +1,100 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace riser
+{
+    // Low-frequency oscillator evaluated once per control block rather than per sample.
+    // The sine shape comes from a quadrature oscillator (a rotating unit phasor), so steady
+    // running costs a couple of multiplies per control block and no trig calls; the other
+    // shapes are read straight off the phase accumulator.
+    class Lfo
+    {
+    public:
+        enum class Shape { sine, triangle, sawUp, square };
+
+        void setSampleRate(double newSampleRate);
+        void setShape(Shape newShape)               { shape = newShape; }
+
+        // Free-running rate in Hz; clears any tempo sync
+        void setFrequency(double newFrequencyHz);
+
+        // Locks one cycle to this many quarter notes at the host tempo; 0 returns to free running
+        void setTempoSync(double newBeatsPerCycle);
+        void setTempo(double newBpm);
+        bool isTempoSynced() const noexcept         { return beatsPerCycle > 0.0; }
+
+        // Aligns the phase with the host's musical position while tempo synced
+        void syncToPosition(double ppqPosition);
+
+        void reset(double startPhase = 0.0);
+
+        // Moves the oscillator on by numSamples and returns the new value in [-1, 1]
+        float advance(int numSamples);
+        float getValue() const noexcept;
+
+    private:
+        void updateIncrement();
+        void setPhase(double newPhase);
+
+        Shape shape = Shape::sine;
+        double sampleRate = 44100.0;
+        double frequency = 1.0;
+        double beatsPerCycle = 0.0;
+        double tempo = 120.0;
+        double cyclesPerSample = 0.0;
+        double phase = 0.0;
+
+        // Quadrature state: (cosine, sine) of the phase, plus the rotation for one step
+        double phasorCos = 1.0, phasorSin = 0.0;
+        double rotationCos = 1.0, rotationSin = 0.0;
+        int rotationStepSamples = 0;
+    };
+
+    // Equal-power pan law read from lookup tables instead of evaluating cos/sin per sample.
+    // The tables never change, so every instance in the process shares one set through a
+    // juce::SharedResourcePointer.
+    class PanLaw
+    {
+    public:
+        PanLaw();
+
+        // pan in [-1, 1]: -1 is hard left, 0 is centre (-3 dB each side), 1 is hard right
+        void getGains(float pan, float& leftGain, float& rightGain) const noexcept
+        {
+            const auto clampedPan = juce::jlimit(-1.0f, 1.0f, pan);
+            leftGain = leftTable.processSampleUnchecked(clampedPan);
+            rightGain = rightTable.processSampleUnchecked(clampedPan);
+        }
+
+    private:
+        juce::dsp::LookupTableTransform<float> leftTable, rightTable;
+    };
+
+    // Owns the plugin's LFOs and the host tempo they sync to. Modulation targets read LFO
+    // values once per control block and interpolate whatever they derive from them across
+    // the block, so adding a target never adds per-sample trig.
+    class ModulationEngine
+    {
+    public:
+        static constexpr int maxLfos = 4;
+
+        void prepare(double sampleRate);
+        void reset();
+
+        Lfo& getLfo(int index) noexcept                 { return lfos[static_cast<size_t>(index)]; }
+        const PanLaw& getPanLaw() const noexcept        { return *panLaw; }
+
+        // Pulls tempo and position from the host once per processBlock call. Either may be missing.
+        void setHostPosition(juce::Optional<double> bpm, juce::Optional<double> ppqPosition, bool isPlaying);
+
+        // Advances every LFO by one control block
+        void advance(int numSamples);
+        float getValue(int index) const noexcept        { return values[static_cast<size_t>(index)]; }
+
+    private:
+        std::array<Lfo, maxLfos> lfos;
+        std::array<float, maxLfos> values {};
+        juce::SharedResourcePointer<PanLaw> panLaw;
+    };
+}
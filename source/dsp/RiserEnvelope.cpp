@@ -0,0 +1,84 @@
+#include "RiserEnvelope.h"
+
+namespace riser
+{
+    void RiserEnvelope::prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    void RiserEnvelope::reset()
+    {
+        blockStartQuarterNotes = 0.0;
+        freeRunQuarterNotes = 0.0;
+        active = false;
+    }
+
+    void RiserEnvelope::beginBlock(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, int numSamples)
+    {
+        juce::Optional<double> ppqPosition;
+        bool isPlaying = true;
+
+        if (position.hasValue()) {
+            if (const auto bpm = position->getBpm(); bpm.hasValue() && *bpm > 0.0)
+                tempo = *bpm;
+
+            if (const auto timeSignature = position->getTimeSignature(); timeSignature.hasValue() && timeSignature->denominator > 0)
+                beatsPerBar = 4.0 * timeSignature->numerator / timeSignature->denominator;
+
+            ppqPosition = position->getPpqPosition();
+            isPlaying = position->getIsPlaying();
+        }
+
+        quarterNotesPerSample = tempo / (60.0 * sampleRate);
+
+        if (ppqPosition.hasValue()) {
+            blockStartQuarterNotes = *ppqPosition;
+            freeRunQuarterNotes = *ppqPosition;
+        } else {
+            blockStartQuarterNotes = freeRunQuarterNotes;
+        }
+
+        freeRunQuarterNotes += quarterNotesPerSample * numSamples;
+        active = bars > 0.0 && isPlaying;
+    }
+
+    float RiserEnvelope::getValueAt(int sampleOffset) const noexcept
+    {
+        const auto lengthQuarterNotes = bars * beatsPerBar;
+        if (! active || lengthQuarterNotes <= 0.0)
+            return 1.0f;
+
+        const auto position = blockStartQuarterNotes + quarterNotesPerSample * sampleOffset;
+        const auto cycles = position / lengthQuarterNotes;
+        return shape(cycles - std::floor(cycles));
+    }
+
+    int RiserEnvelope::getSamplesToNextCycle(int sampleOffset) const noexcept
+    {
+        const auto lengthQuarterNotes = bars * beatsPerBar;
+        if (! active || lengthQuarterNotes <= 0.0 || quarterNotesPerSample <= 0.0)
+            return std::numeric_limits<int>::max();
+
+        const auto position = blockStartQuarterNotes + quarterNotesPerSample * sampleOffset;
+        const auto nextCycle = (std::floor(position / lengthQuarterNotes) + 1.0) * lengthQuarterNotes;
+        const auto nextSample = std::ceil((nextCycle - blockStartQuarterNotes) / quarterNotesPerSample);
+        return static_cast<int>(juce::jlimit(1.0, static_cast<double>(std::numeric_limits<int>::max()), nextSample - sampleOffset));
+    }
+
+    // Polynomials rather than pow/exp, since this runs every control block
+    float RiserEnvelope::shape(double phase) const noexcept
+    {
+        const auto t = static_cast<float>(phase);
+
+        switch (curve) {
+            case Curve::linear:         return t;
+            case Curve::exponential:    return t * t * t;
+            case Curve::logarithmic:    return 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t);
+            case Curve::sCurve:         return t * t * (3.0f - 2.0f * t);
+        }
+
+        return t;
+    }
+}
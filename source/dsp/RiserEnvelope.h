@@ -0,0 +1,53 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace riser
+{
+    // Internal Impact envelope: ramps from 0 to 1 over a number of bars, then starts again,
+    // locked to the host's musical position. Its value can be read at any sample of the block
+    // because the position is extrapolated from the block start at the host tempo, so the
+    // ramp doesn't depend on how densely the host would have drawn automation.
+    //
+    // While the host transport runs, every block resyncs to its position; while it is stopped
+    // the envelope is inactive. Without a play head (or one without a position) it free-runs
+    // from where it was at the last known tempo.
+    class RiserEnvelope
+    {
+    public:
+        enum class Curve { linear, exponential, logarithmic, sCurve };
+
+        void prepare(double newSampleRate);
+        void reset();
+
+        // 0 bars turns the envelope off
+        void setLength(double newBars) noexcept                 { bars = juce::jmax(0.0, newBars); }
+        void setCurve(Curve newCurve) noexcept                  { curve = newCurve; }
+
+        // Call once per block before reading values
+        void beginBlock(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, int numSamples);
+
+        bool isActive() const noexcept                          { return active; }
+
+        // Envelope value in [0, 1] at sampleOffset samples into the current block
+        float getValueAt(int sampleOffset) const noexcept;
+
+        // Samples from sampleOffset to the first sample of the next cycle, at least 1; the
+        // largest int while inactive
+        int getSamplesToNextCycle(int sampleOffset) const noexcept;
+
+    private:
+        float shape(double phase) const noexcept;
+
+        double sampleRate = 44100.0;
+        double bars = 0.0;
+        Curve curve = Curve::linear;
+
+        double tempo = 120.0;
+        double beatsPerBar = 4.0;                   // In quarter notes
+        double blockStartQuarterNotes = 0.0;
+        double freeRunQuarterNotes = 0.0;
+        double quarterNotesPerSample = 0.0;
+        bool active = false;
+    };
+}
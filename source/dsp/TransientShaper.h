@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Lanes.h"
+
+namespace riser
+{
+    // Transient designer built on two envelope followers per lane. A fast and a slow one-pole
+    // follower track the same fast-release peak: where the fast one leads, the signal is in an
+    // attack. A second peak with a long release outlasts the fast one in the decay, which is
+    // the sustain. Both differences are taken relative to the current level, so the gain
+    // depends on the envelope's shape rather than on how loud the input is:
+    //
+    //     gain = 1 + attack * (fast - slow) / level + sustain * (longPeak - fastPeak) / level
+    //
+    // Positive amounts emphasise, negative ones soften. With lookahead the audio runs through
+    // a short delay while the followers see the undelayed input, so the gain is already moving
+    // when an onset reaches the output.
+    template <typename VectorType>
+    class TransientShaper
+    {
+    public:
+        using Element = typename Lanes<VectorType>::Element;
+
+        void prepare(double sampleRate, int newLookaheadSamples)
+        {
+            fastAttack = smoothingCoefficient(sampleRate, 0.0005);
+            slowAttack = smoothingCoefficient(sampleRate, 0.025);
+            fastRelease = releaseMultiplier(sampleRate, 0.02);
+            longRelease = releaseMultiplier(sampleRate, 0.25);
+
+            lookaheadSamples = static_cast<size_t>(juce::jmax(0, newLookaheadSamples));
+            const auto size = juce::nextPowerOfTwo(static_cast<int>(lookaheadSamples) + 1);
+            lookahead.assign(lookaheadSamples > 0 ? static_cast<size_t>(size) : 0, Lanes<VectorType>::expand(0));
+            mask = static_cast<size_t>(size - 1);
+
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            const auto zero = Lanes<VectorType>::expand(0);
+            fastPeak = longPeak = fast = slow = zero;
+            std::fill(lookahead.begin(), lookahead.end(), zero);
+            writeIndex = 0;
+        }
+
+        int getLatencySamples() const noexcept                  { return static_cast<int>(lookaheadSamples); }
+
+        void process(VectorType* data, size_t numSamples, Element attackAmount, Element sustainAmount) noexcept
+        {
+            const auto zero = Lanes<VectorType>::expand(0);
+            const auto one = Lanes<VectorType>::expand(1);
+            const auto highestGain = Lanes<VectorType>::expand(maxGain);
+            const auto levelFloor = Lanes<VectorType>::expand(minLevel);
+
+            for (size_t i = 0; i < numSamples; ++i) {
+                const auto input = data[i];
+                const auto level = Lanes<VectorType>::abs(input);
+
+                fastPeak = Lanes<VectorType>::max(level, fastPeak * fastRelease);
+                longPeak = Lanes<VectorType>::max(level, longPeak * longRelease);
+                fast += (fastPeak - fast) * fastAttack;
+                slow += (fastPeak - slow) * slowAttack;
+
+                const auto attack = Lanes<VectorType>::max(fast - slow, zero);
+                const auto sustain = Lanes<VectorType>::max(longPeak - fastPeak, zero);
+                const auto reference = Lanes<VectorType>::max(Lanes<VectorType>::max(fast, longPeak), levelFloor);
+                const auto shaping = Lanes<VectorType>::divide(attack * attackAmount + sustain * sustainAmount, reference);
+                const auto gain = Lanes<VectorType>::max(zero, Lanes<VectorType>::min(highestGain, one + shaping));
+
+                auto output = input;
+                if (lookaheadSamples > 0) {
+                    lookahead[writeIndex] = input;
+                    output = lookahead[(writeIndex - lookaheadSamples) & mask];
+                    writeIndex = (writeIndex + 1) & mask;
+                }
+
+                data[i] = output * gain;
+            }
+        }
+
+    private:
+        static Element smoothingCoefficient(double sampleRate, double seconds)
+        {
+            return static_cast<Element>(1.0 - std::exp(-1.0 / (seconds * sampleRate)));
+        }
+
+        // Per-sample decay that falls by 60 dB over the given time
+        static Element releaseMultiplier(double sampleRate, double seconds)
+        {
+            return static_cast<Element>(std::pow(0.001, 1.0 / (seconds * sampleRate)));
+        }
+
+        static constexpr Element maxGain = Element(3);
+        static constexpr Element minLevel = Element(1.0e-6);
+
+        Element fastAttack = 0, slowAttack = 0, fastRelease = 0, longRelease = 0;
+        VectorType fastPeak = Lanes<VectorType>::expand(0), longPeak = Lanes<VectorType>::expand(0);
+        VectorType fast = Lanes<VectorType>::expand(0), slow = Lanes<VectorType>::expand(0);
+
+        std::vector<VectorType> lookahead;
+        size_t lookaheadSamples = 0, mask = 0, writeIndex = 0;
+    };
+}
@@ -84,4 +84,46 @@ document.addEventListener("DOMContentLoaded", () => {
   
   // Initialize knob to 0 position
   updateKnobVisual(0);
+  
+  // Telemetry from the audio thread, batched by the editor at a fixed UI rate
+  const telemetryView = document.getElementById("telemetry");
+  const setTelemetryEnabled = Juce.getNativeFunction("setTelemetryEnabled");
+  
+  function toDecibels(gain) {
+    return gain > 0 ? (20 * Math.log10(gain)).toFixed(1) : "-inf";
+  }
+  
+  window.__JUCE__.backend.addEventListener("telemetry", (batch) => {
+    const frames = batch.frames;
+    if (!frames || frames.length === 0) return;
+    
+    // Stage times are averaged over the batch; levels and budget use the worst block
+    const stageTotals = {};
+    let peak = 0;
+    let worstBudget = 0;
+    
+    for (const frame of frames) {
+      peak = Math.max(peak, frame.peak);
+      worstBudget = Math.max(worstBudget, frame.budgetPercent);
+      
+      for (const [stage, micros] of Object.entries(frame.stageMicros)) {
+        stageTotals[stage] = (stageTotals[stage] || 0) + micros;
+      }
+    }
+    
+    const stages = Object.entries(stageTotals)
+      .map(([stage, total]) => `${stage} ${(total / frames.length).toFixed(1)}`)
+      .join("  ");
+    const last = frames[frames.length - 1];
+    
+    telemetryView.textContent =
+      `#${batch.instance}  cpu ${worstBudget.toFixed(1)}%  peak ${toDecibels(peak)} dB  reduction ${last.reductionDb.toFixed(1)} dB\n` +
+      `us/block  ${stages}\n` +
+      `overruns ${last.overruns}  dropped ${last.dropped}`;
+  });
+  
+  // Double-click toggles the telemetry overlay; the processor only measures while it's shown
+  document.addEventListener("dblclick", () => {
+    setTelemetryEnabled(telemetryView.classList.toggle("visible"));
+  });
 });
\ No newline at end of file
@@ -0,0 +1,387 @@
+#include <JuceHeader.h>
+#include "../../source/PluginProcessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+// Headless harness that drives MiniRiserAudioProcessor through prepareToPlay/processBlock
+// without a host or editor, and reports per-sample cost and per-block latency statistics.
+// With --engine it times the channel engine alone instead, SIMD-packed against one channel
+// per lane group, so the two builds of MINIRISER_SIMD_ENGINE can be compared in one run.
+
+namespace
+{
+    struct Options {
+        juce::Array<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+        juce::Array<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+        juce::Array<float> impacts { 0.0f, 25.0f, 50.0f, 75.0f, 100.0f };
+        juce::Array<int> channelCounts { 1, 2, 4, 6, 8 };
+        juce::File inputFile;
+        double secondsPerCase = 5.0;
+        double warmupSeconds = 1.0;
+        int oversampling = 0;
+        bool linearPhase = false;
+        bool doublePrecision = false;
+        bool engineOnly = false;
+        bool csv = false;
+    };
+
+    struct CaseResult {
+        double nsPerSample = 0.0;
+        double realtimeFactor = 0.0;
+        double meanBlockMicros = 0.0;
+        double p99BlockMicros = 0.0;
+        double worstBlockMicros = 0.0;
+        double worstPercentOfDeadline = 0.0;
+    };
+
+    template <typename ValueType>
+    juce::Array<ValueType> parseList(const juce::String& text)
+    {
+        juce::Array<ValueType> values;
+        for (auto& token : juce::StringArray::fromTokens(text, ",", {}))
+            if (token.trim().isNotEmpty())
+                values.add(static_cast<ValueType>(token.trim().getDoubleValue()));
+        return values;
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: MiniRiserBenchmark [options]\n"
+                     "  --input <file.wav>     Use a WAV file as input (default: synthetic signal)\n"
+                     "  --blocks 16,64,...     Block sizes to test\n"
+                     "  --rates 44100,...      Sample rates to test\n"
+                     "  --impacts 0,50,...     Impact values (0-100) to test\n"
+                     "  --seconds <s>          Audio seconds processed per case (default 5)\n"
+                     "  --warmup <s>           Untimed seconds processed before each case (default 1)\n"
+                     "  --oversampling <n>     Oversample the crusher 1, 2, 4 or 8 times (default 1)\n"
+                     "  --linear-phase         Use linear-phase oversampling filters\n"
+                     "  --double               Process 64-bit buffers, as a double-precision host would\n"
+                     "  --engine               Time the channel engine alone, SIMD against scalar\n"
+                     "  --channels 2,4,...     Channel counts for --engine (default 1,2,4,6,8)\n"
+                     "  --csv                  Print results as CSV\n";
+    }
+
+    bool parseOptions(const juce::StringArray& args, Options& options)
+    {
+        for (int i = 0; i < args.size(); ++i) {
+            const auto& arg = args[i];
+            const auto next = [&]() { return i + 1 < args.size() ? args[++i] : juce::String(); };
+
+            if (arg == "--blocks")        options.blockSizes = parseList<int>(next());
+            else if (arg == "--rates")    options.sampleRates = parseList<double>(next());
+            else if (arg == "--impacts")  options.impacts = parseList<float>(next());
+            else if (arg == "--seconds")  options.secondsPerCase = next().getDoubleValue();
+            else if (arg == "--warmup")   options.warmupSeconds = next().getDoubleValue();
+            else if (arg == "--oversampling") options.oversampling = juce::jlimit(0, 3, juce::roundToInt(std::log2(juce::jmax(1, next().getIntValue()))));
+            else if (arg == "--linear-phase") options.linearPhase = true;
+            else if (arg == "--double")   options.doublePrecision = true;
+            else if (arg == "--engine")   options.engineOnly = true;
+            else if (arg == "--channels") options.channelCounts = parseList<int>(next());
+            else if (arg == "--input")    options.inputFile = juce::File::getCurrentWorkingDirectory().getChildFile(next());
+            else if (arg == "--csv")      options.csv = true;
+            else {
+                printUsage();
+                return false;
+            }
+        }
+
+        return ! options.blockSizes.isEmpty() && ! options.sampleRates.isEmpty()
+            && ! options.impacts.isEmpty() && ! options.channelCounts.isEmpty()
+            && options.secondsPerCase > 0.0;
+    }
+
+    // One second of decorrelated noise plus a slow sine sweep, roughly what a riser is fed with.
+    juce::AudioBuffer<float> makeSyntheticInput(double sampleRate)
+    {
+        juce::AudioBuffer<float> signal(2, static_cast<int>(sampleRate));
+        juce::Random random(0x5eed);
+        double phase = 0.0;
+
+        for (int sample = 0; sample < signal.getNumSamples(); ++sample) {
+            const double t = sample / sampleRate;
+            const double frequency = 80.0 + 4000.0 * t * t;
+            phase += juce::MathConstants<double>::twoPi * frequency / sampleRate;
+            const float tone = 0.25f * static_cast<float>(std::sin(phase));
+
+            for (int channel = 0; channel < signal.getNumChannels(); ++channel)
+                signal.setSample(channel, sample, tone + 0.1f * (random.nextFloat() * 2.0f - 1.0f));
+        }
+
+        return signal;
+    }
+
+    bool loadWavInput(const juce::File& file, juce::AudioBuffer<float>& signal)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if (reader == nullptr || reader->lengthInSamples <= 0)
+            return false;
+
+        const auto numSamples = static_cast<int>(juce::jmin<juce::int64>(reader->lengthInSamples, 1 << 24));
+        signal.setSize(2, numSamples);
+        reader->read(&signal, 0, numSamples, 0, true, true);
+
+        // Mono files are duplicated across both channels
+        if (reader->numChannels == 1)
+            signal.copyFrom(1, 0, signal, 0, 0, numSamples);
+
+        return true;
+    }
+
+    void fillBlock(juce::AudioBuffer<float>& block, const juce::AudioBuffer<float>& signal, int& readPosition)
+    {
+        for (int offset = 0; offset < block.getNumSamples();) {
+            const int count = juce::jmin(block.getNumSamples() - offset, signal.getNumSamples() - readPosition);
+
+            for (int channel = 0; channel < block.getNumChannels(); ++channel)
+                block.copyFrom(channel, offset, signal, channel, readPosition, count);
+
+            offset += count;
+            readPosition = (readPosition + count) % signal.getNumSamples();
+        }
+    }
+
+    CaseResult runCase(const Options& options, const juce::AudioBuffer<float>& signal,
+                       double sampleRate, int blockSize, float impact)
+    {
+        MiniRiserAudioProcessor processor;
+
+        // Quality settings are picked up by prepareToPlay, so they go in first
+        const auto setChoice = [&processor](const char* id, int index) {
+            auto* parameter = processor.getState().getParameter(id);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(static_cast<float>(index)));
+        };
+        setChoice("oversampling", options.oversampling);
+        setChoice("oversamplingMode", options.linearPhase ? 1 : 0);
+
+        processor.setProcessingPrecision(options.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                 : juce::AudioProcessor::singlePrecision);
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        auto* impactParameter = processor.getState().getParameter("impact");
+        impactParameter->setValueNotifyingHost(impactParameter->convertTo0to1(impact));
+
+        juce::AudioBuffer<float> block(2, blockSize);
+        juce::AudioBuffer<double> doubleBlock(2, blockSize);
+        juce::MidiBuffer midi;
+        int readPosition = 0;
+
+        // The input is converted outside the timed region, so both precisions time only the plugin
+        const auto fillNext = [&]() {
+            fillBlock(block, signal, readPosition);
+            if (options.doublePrecision)
+                doubleBlock.makeCopyOf(block, true);
+        };
+
+        const auto processNext = [&]() {
+            if (options.doublePrecision)
+                processor.processBlock(doubleBlock, midi);
+            else
+                processor.processBlock(block, midi);
+        };
+
+        const auto warmupBlocks = static_cast<int>(std::ceil(options.warmupSeconds * sampleRate / blockSize));
+        for (int i = 0; i < warmupBlocks; ++i) {
+            fillNext();
+            processNext();
+        }
+
+        const auto numBlocks = juce::jmax(1, static_cast<int>(std::ceil(options.secondsPerCase * sampleRate / blockSize)));
+        std::vector<double> blockNanos(static_cast<size_t>(numBlocks));
+
+        for (auto& nanos : blockNanos) {
+            fillNext();
+
+            const auto start = std::chrono::steady_clock::now();
+            processNext();
+            const auto end = std::chrono::steady_clock::now();
+
+            nanos = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+
+        processor.releaseResources();
+
+        double totalNanos = 0.0;
+        for (auto nanos : blockNanos)
+            totalNanos += nanos;
+
+        const double totalSamples = static_cast<double>(numBlocks) * blockSize;
+        const double deadlineNanos = 1.0e9 * blockSize / sampleRate;
+
+        auto sorted = blockNanos;
+        const auto p99Index = juce::jmin(sorted.size() - 1, static_cast<size_t>(0.99 * static_cast<double>(sorted.size())));
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(p99Index), sorted.end());
+        const double worstNanos = *std::max_element(blockNanos.begin(), blockNanos.end());
+
+        CaseResult result;
+        result.nsPerSample = totalNanos / totalSamples;
+        result.realtimeFactor = (1.0e9 * totalSamples / sampleRate) / juce::jmax(1.0, totalNanos);
+        result.meanBlockMicros = totalNanos / numBlocks * 1.0e-3;
+        result.p99BlockMicros = sorted[p99Index] * 1.0e-3;
+        result.worstBlockMicros = worstNanos * 1.0e-3;
+        result.worstPercentOfDeadline = 100.0 * worstNanos / deadlineNanos;
+        return result;
+    }
+
+    // Drives one ChannelEngine the way processControlBlock does with oversampling off: host
+    // blocks cut into 32-sample control blocks, the stages before and after the reverb in a
+    // single pass each, and the pan and output gain ramping. Returns nanoseconds per sample
+    // frame, so cases with different channel counts compare per frame rather than per channel.
+    template <typename VectorType>
+    double timeEngine(const Options& options, const juce::AudioBuffer<float>& signal,
+                      double sampleRate, int blockSize, int numChannels)
+    {
+        using Engine = riser::ChannelEngine<VectorType>;
+        using Element = typename Engine::Element;
+        constexpr int controlRateSamples = 32;
+
+        Engine engine;
+        engine.prepare({ sampleRate, static_cast<juce::uint32>(controlRateSamples), static_cast<juce::uint32>(numChannels) },
+                       juce::dsp::IIR::Coefficients<Element>::makeHighPass(sampleRate, Element(20)),
+                       static_cast<int>(sampleRate), juce::roundToInt(sampleRate * 0.005));
+
+        typename Engine::Parameters parameters;
+        parameters.transientAttack = Element(0.5);
+        parameters.transientSustain = Element(-0.3);
+        parameters.bitDepth = Element(10);
+        parameters.downsampleFactor = Element(2);
+
+        const std::vector<Element> wetLevels(controlRateSamples, Element(0.3));
+        const std::vector<Element> feedbackLevels(controlRateSamples, Element(0.4));
+        std::vector<Element> panStart(static_cast<size_t>(numChannels), Element(0.8));
+        std::vector<Element> panEnd(static_cast<size_t>(numChannels), Element(0.9));
+        const auto delaySamples = static_cast<Element>(0.25 * sampleRate);
+
+        juce::AudioBuffer<Element> block(numChannels, blockSize);
+        juce::AudioBuffer<float> source(2, blockSize);
+        int readPosition = 0;
+
+        const auto fillNext = [&]() {
+            fillBlock(source, signal, readPosition);
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int sample = 0; sample < blockSize; ++sample)
+                    block.setSample(channel, sample, static_cast<Element>(source.getSample(channel % 2, sample)));
+        };
+
+        const auto processNext = [&]() {
+            juce::dsp::AudioBlock<Element> hostBlock(block);
+
+            for (int start = 0; start < blockSize; start += controlRateSamples) {
+                const auto length = static_cast<size_t>(juce::jmin(controlRateSamples, blockSize - start));
+                auto controlBlock = hostBlock.getSubBlock(static_cast<size_t>(start), length);
+                engine.processPreReverb(controlBlock, parameters, panStart.data(), panEnd.data());
+                engine.processPostReverb(controlBlock, wetLevels.data(), feedbackLevels.data(),
+                                         delaySamples, delaySamples, Element(0.9), Element(1));
+                std::swap(panStart, panEnd);
+            }
+        };
+
+        const auto warmupBlocks = static_cast<int>(std::ceil(options.warmupSeconds * sampleRate / blockSize));
+        for (int i = 0; i < warmupBlocks; ++i) {
+            fillNext();
+            processNext();
+        }
+
+        const auto numBlocks = juce::jmax(1, static_cast<int>(std::ceil(options.secondsPerCase * sampleRate / blockSize)));
+        double totalNanos = 0.0;
+
+        for (int i = 0; i < numBlocks; ++i) {
+            fillNext();
+
+            const auto start = std::chrono::steady_clock::now();
+            processNext();
+            const auto end = std::chrono::steady_clock::now();
+
+            totalNanos += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+
+        return totalNanos / (static_cast<double>(numBlocks) * blockSize);
+    }
+
+    template <typename Element>
+    void runEngineCases(const Options& options, const juce::AudioBuffer<float>& wavInput)
+    {
+        if (options.csv)
+            std::printf("sample_rate,block_size,channels,scalar_ns_per_sample,simd_ns_per_sample,simd_lanes,speedup\n");
+        else
+            std::printf("%9s %6s %8s %12s %12s %6s %8s\n", "rate", "block", "channels", "scalar ns", "simd ns", "lanes", "speedup");
+
+        constexpr auto numLanes = riser::Lanes<juce::dsp::SIMDRegister<Element>>::count;
+
+        for (auto sampleRate : options.sampleRates) {
+            const auto signal = wavInput.getNumSamples() > 0 ? wavInput : makeSyntheticInput(sampleRate);
+
+            for (auto blockSize : options.blockSizes) {
+                for (auto numChannels : options.channelCounts) {
+                    const auto scalar = timeEngine<Element>(options, signal, sampleRate, blockSize, numChannels);
+                    const auto simd = timeEngine<juce::dsp::SIMDRegister<Element>>(options, signal, sampleRate, blockSize, numChannels);
+
+                    const auto* format = options.csv ? "%.0f,%d,%d,%.3f,%.3f,%d,%.2f\n"
+                                                     : "%9.0f %6d %8d %12.3f %12.3f %6d %8.2f\n";
+                    std::printf(format, sampleRate, blockSize, numChannels, scalar, simd,
+                                static_cast<int>(numLanes), scalar / juce::jmax(1.0e-9, simd));
+                    std::fflush(stdout);
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    Options options;
+    if (! parseOptions(args, options))
+        return 1;
+
+    juce::AudioBuffer<float> wavInput;
+    if (options.inputFile != juce::File() && ! loadWavInput(options.inputFile, wavInput)) {
+        std::cerr << "Could not read input file: " << options.inputFile.getFullPathName() << "\n";
+        return 1;
+    }
+
+    if (options.engineOnly) {
+        if (options.doublePrecision)
+            runEngineCases<double>(options, wavInput);
+        else
+            runEngineCases<float>(options, wavInput);
+
+        return 0;
+    }
+
+    if (options.csv)
+        std::printf("sample_rate,block_size,impact,ns_per_sample,realtime_factor,mean_block_us,p99_block_us,worst_block_us,worst_pct_deadline\n");
+    else
+        std::printf("%9s %6s %7s %12s %10s %11s %11s %11s %10s\n", "rate", "block", "impact", "ns/sample",
+                    "x realtime", "mean us", "p99 us", "worst us", "worst %dl");
+
+    for (auto sampleRate : options.sampleRates) {
+        const auto signal = wavInput.getNumSamples() > 0 ? wavInput : makeSyntheticInput(sampleRate);
+
+        for (auto blockSize : options.blockSizes) {
+            for (auto impact : options.impacts) {
+                const auto r = runCase(options, signal, sampleRate, blockSize, impact);
+
+                const auto* format = options.csv ? "%.0f,%d,%.1f,%.3f,%.2f,%.3f,%.3f,%.3f,%.2f\n"
+                                                 : "%9.0f %6d %7.1f %12.3f %10.2f %11.3f %11.3f %11.3f %10.2f\n";
+                std::printf(format, sampleRate, blockSize, static_cast<double>(impact), r.nsPerSample,
+                            r.realtimeFactor, r.meanBlockMicros, r.p99BlockMicros, r.worstBlockMicros,
+                            r.worstPercentOfDeadline);
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    return 0;
+}
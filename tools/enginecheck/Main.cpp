@@ -0,0 +1,185 @@
+#include <JuceHeader.h>
+#include "../../source/dsp/ChannelEngine.h"
+
+#include <iostream>
+
+// Runs the channel engine packed into SIMD registers and one channel at a time over the same
+// input and parameters, and compares the samples after every stage: the two builds of
+// MINIRISER_SIMD_ENGINE must give exactly the same output. Exits non-zero on the first
+// mismatch per case; run by CTest.
+
+namespace
+{
+    int failures = 0;
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int maxBlockSize = 256;
+
+    template <typename Element>
+    class Comparison
+    {
+    public:
+        Comparison(int numChannelsToUse, int lookaheadSamples)
+            : panStart(static_cast<size_t>(numChannelsToUse)),
+              panEnd(static_cast<size_t>(numChannelsToUse)),
+              wetLevels(maxBlockSize),
+              feedbackLevels(maxBlockSize),
+              numChannels(numChannelsToUse),
+              scalarBuffer(numChannelsToUse, maxBlockSize),
+              simdBuffer(numChannelsToUse, maxBlockSize)
+        {
+            const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(maxBlockSize), static_cast<juce::uint32>(numChannels) };
+            const auto coefficients = juce::dsp::IIR::Coefficients<Element>::makeHighPass(sampleRate, Element(20));
+            const auto maxDelaySamples = static_cast<int>(sampleRate);
+
+            scalar.prepare(spec, coefficients, maxDelaySamples, lookaheadSamples);
+            simd.prepare(spec, coefficients, maxDelaySamples, lookaheadSamples);
+        }
+
+        // Fills both buffers with the same input and picks this block's parameters. Bursts of
+        // noise with short gaps keep the transient shaper's followers moving; the long gap lets
+        // every stage's state decay towards zero, as in a tail ringing out.
+        void nextBlock(int blockIndex, int numSamples)
+        {
+            blockSize = numSamples;
+            const bool silent = blockIndex % 7 == 6 || (blockIndex >= 200 && blockIndex < 1200);
+            const auto burst = static_cast<Element>(0.2 + 0.8 * std::abs(std::sin(blockIndex * 0.37)));
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                for (int sample = 0; sample < numSamples; ++sample) {
+                    const auto value = silent ? Element(0) : burst * static_cast<Element>(random.nextDouble() * 2.0 - 1.0);
+                    scalarBuffer.setSample(channel, sample, value);
+                    simdBuffer.setSample(channel, sample, value);
+                }
+
+                panStart[static_cast<size_t>(channel)] = static_cast<Element>(random.nextDouble());
+                panEnd[static_cast<size_t>(channel)] = static_cast<Element>(random.nextDouble());
+            }
+
+            const Element bitDepths[] { Element(24), Element(8), Element(3.5), Element(12) };
+            const Element downsampleFactors[] { Element(1), Element(2.5), Element(1), Element(6) };
+            parameters.bitDepth = bitDepths[blockIndex % 4];
+            parameters.downsampleFactor = downsampleFactors[(blockIndex / 4) % 4];
+            parameters.antialias = blockIndex % 3 != 0;
+            parameters.transientAttack = static_cast<Element>(random.nextDouble() * 2.0 - 1.0);
+            parameters.transientSustain = static_cast<Element>(random.nextDouble() * 2.0 - 1.0);
+
+            for (int sample = 0; sample < numSamples; ++sample) {
+                wetLevels[static_cast<size_t>(sample)] = static_cast<Element>(random.nextDouble());
+                feedbackLevels[static_cast<size_t>(sample)] = static_cast<Element>(random.nextDouble() * 0.9);
+            }
+
+            delayStart = static_cast<Element>(1 + random.nextInt(maxBlockSize * 4)) + static_cast<Element>(random.nextDouble());
+            delayEnd = delayStart + static_cast<Element>(random.nextDouble() * 8.0 - 4.0);
+            gainStart = static_cast<Element>(random.nextDouble() * 2.0);
+            gainEnd = static_cast<Element>(random.nextDouble() * 2.0);
+        }
+
+        // Runs one stage on both engines and reports whether their output still matches
+        template <typename Stage>
+        bool run(Stage&& stage)
+        {
+            auto scalarBlock = juce::dsp::AudioBlock<Element>(scalarBuffer).getSubBlock(0, static_cast<size_t>(blockSize));
+            auto simdBlock = juce::dsp::AudioBlock<Element>(simdBuffer).getSubBlock(0, static_cast<size_t>(blockSize));
+            stage(scalar, scalarBlock);
+            stage(simd, simdBlock);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int sample = 0; sample < blockSize; ++sample)
+                    if (scalarBuffer.getSample(channel, sample) != simdBuffer.getSample(channel, sample))
+                        return false;
+
+            return true;
+        }
+
+        // The two engines' Parameters are distinct types with the same fields
+        template <typename Engine>
+        typename Engine::Parameters getParameters(const Engine&) const
+        {
+            typename Engine::Parameters engineParameters;
+            engineParameters.transientAttack = parameters.transientAttack;
+            engineParameters.transientSustain = parameters.transientSustain;
+            engineParameters.bitDepth = parameters.bitDepth;
+            engineParameters.downsampleFactor = parameters.downsampleFactor;
+            engineParameters.antialias = parameters.antialias;
+            return engineParameters;
+        }
+
+        typename riser::ChannelEngine<Element>::Parameters parameters;
+        std::vector<Element> panStart, panEnd, wetLevels, feedbackLevels;
+        Element delayStart = 1, delayEnd = 1, gainStart = 1, gainEnd = 1;
+
+    private:
+        const int numChannels;
+        int blockSize = 0;
+        juce::Random random { 0x5eed };
+        juce::AudioBuffer<Element> scalarBuffer, simdBuffer;
+        riser::ChannelEngine<Element> scalar;
+        riser::ChannelEngine<juce::dsp::SIMDRegister<Element>> simd;
+    };
+
+    // Drives the engines the way processControlBlock does: the fused pass without oversampling,
+    // or the stages one by one with the crusher on a longer, oversampled block
+    template <typename Element>
+    void checkEngines(const char* typeName, int numChannels, int lookaheadSamples, bool split)
+    {
+        Comparison<Element> comparison(numChannels, lookaheadSamples);
+        const int blockSizes[] { 32, 32, 17, 1, 32, 5, 32, 31 };
+
+        for (int block = 0; block < 1400; ++block) {
+            const int numSamples = blockSizes[block % 8];
+            comparison.nextBlock(block, numSamples);
+
+            auto& c = comparison;
+            const char* failedStage = nullptr;
+            const auto check = [&](const char* stageName, auto&& stage) {
+                if (failedStage == nullptr && ! c.run(stage))
+                    failedStage = stageName;
+            };
+
+            if (split) {
+                check("high-pass", [&](auto& engine, auto& b) { engine.processFilter(b); });
+                check("transient", [&](auto& engine, auto& b) { engine.processTransients(b, c.getParameters(engine)); });
+                check("crusher", [&](auto& engine, auto& b) { engine.processCrusher(b, c.getParameters(engine), Element(block % 2 == 0 ? 1 : 4)); });
+                check("pan", [&](auto& engine, auto& b) { engine.processPan(b, c.panStart.data(), c.panEnd.data()); });
+            } else {
+                check("pre-reverb", [&](auto& engine, auto& b) { engine.processPreReverb(b, c.getParameters(engine), c.panStart.data(), c.panEnd.data()); });
+            }
+
+            check("delay", [&](auto& engine, auto& b) {
+                engine.processPostReverb(b, c.wetLevels.data(), c.feedbackLevels.data(), c.delayStart, c.delayEnd, c.gainStart, c.gainEnd);
+            });
+
+            if (failedStage != nullptr) {
+                std::cerr << "FAILED: " << typeName << ", " << numChannels << " channels, lookahead " << lookaheadSamples
+                          << (split ? ", split" : ", fused") << ": " << failedStage << " differs in block " << block << "\n";
+                ++failures;
+                return;
+            }
+        }
+    }
+
+    template <typename Element>
+    void checkAll(const char* typeName)
+    {
+        for (int numChannels : { 1, 2, 3, 4, 6, 8, 12 })
+            for (int lookaheadSamples : { 0, 240 })
+                for (bool split : { false, true })
+                    checkEngines<Element>(typeName, numChannels, lookaheadSamples, split);
+    }
+}
+
+int main()
+{
+    // As in processBlock, so denormals flush the same way on both paths
+    juce::ScopedNoDenormals noDenormals;
+
+    checkAll<float>("float");
+    checkAll<double>("double");
+
+    if (failures > 0)
+        return 1;
+
+    std::cout << "SIMD and scalar engine output matches\n";
+    return 0;
+}
@@ -0,0 +1,498 @@
+#include <JuceHeader.h>
+#include "../../source/PluginProcessor.h"
+
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// Offline batch renderer: every input file in a manifest is rendered through every variation
+// (a preset, an Impact automation curve, parameter overrides and mapping curves) to its own
+// WAV file. Renders run on all cores with one processor per worker; files are read through
+// memory-mapped readers and written block by block, so memory stays flat however long they are.
+//
+// Manifest (JSON):
+//   {
+//     "inputs": [ "kicks/kick01.wav", ... ],           relative to the manifest
+//     "outputDirectory": "renders",                     default: next to the manifest
+//     "tempo": 128,                                     for synced stages (default 120)
+//     "bitDepth": 24,
+//     "maxTailSeconds": 10,
+//     "variations": [
+//       { "name": "build",                              output is <input>_<name>.wav
+//         "preset": "Build",                            name or index
+//         "impact": [ [0, 0], [1, 100] ],               [position 0-1 in the input, value]
+//         "parameters": { "riseLength": 2 },            plain values; choices take their index
+//         "curves": { "reverbWet": [ [0, 0], [1, 0.8, 1.0] ] } }
+//     ]
+//   }
+
+namespace
+{
+    struct Variation {
+        juce::String name;
+        int program = 0;
+        juce::Array<juce::Point<float>> impact;
+        juce::NamedValueSet parameters;
+        std::vector<std::pair<riser::ImpactMapping::Target, riser::ImpactMapping::Curve>> curves;
+    };
+
+    struct Manifest {
+        juce::Array<juce::File> inputs;
+        std::vector<Variation> variations;
+        juce::File outputDirectory;
+        double tempo = 120.0;
+        int bitDepth = 24;
+        double maxTailSeconds = 10.0;
+    };
+
+    struct Options {
+        juce::File manifestFile;
+        int numWorkers = 0;
+        int blockSize = 512;
+    };
+
+    void printUsage()
+    {
+        std::cout << "Usage: MiniRiserRender <manifest.json> [options]\n"
+                     "  --jobs <n>             Worker threads (default: one per core)\n"
+                     "  --block <n>            Processing block size; Impact automation updates once per block (default 512)\n";
+    }
+
+    bool parseOptions(const juce::StringArray& args, Options& options)
+    {
+        for (int i = 0; i < args.size(); ++i) {
+            const auto& arg = args[i];
+            const auto next = [&]() { return i + 1 < args.size() ? args[++i] : juce::String(); };
+
+            if (arg == "--jobs")          options.numWorkers = next().getIntValue();
+            else if (arg == "--block")    options.blockSize = next().getIntValue();
+            else if (! arg.startsWith("--") && options.manifestFile == juce::File())
+                options.manifestFile = juce::File::getCurrentWorkingDirectory().getChildFile(arg);
+            else {
+                printUsage();
+                return false;
+            }
+        }
+
+        if (options.manifestFile == juce::File() || options.blockSize <= 0) {
+            printUsage();
+            return false;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    riser::ImpactMapping::Curve parseCurve(const juce::var& points)
+    {
+        riser::ImpactMapping::Curve curve;
+        if (auto* array = points.getArray())
+            for (auto& point : *array)
+                if (point.size() >= 2)
+                    curve.push_back({ static_cast<float>(point[0]), static_cast<float>(point[1]),
+                                      point.size() >= 3 ? static_cast<float>(point[2]) : 0.0f });
+        return curve;
+    }
+
+    bool parseVariation(const juce::var& json, MiniRiserAudioProcessor& reference, Variation& variation, juce::String& error)
+    {
+        variation.name = json.getProperty("name", {}).toString();
+        if (variation.name.isEmpty()) {
+            error = "every variation needs a name";
+            return false;
+        }
+
+        const auto preset = json.getProperty("preset", 0);
+        if (preset.isString()) {
+            variation.program = -1;
+            for (int i = 0; i < reference.getNumPrograms(); ++i)
+                if (reference.getProgramName(i).equalsIgnoreCase(preset.toString()))
+                    variation.program = i;
+
+            if (variation.program < 0) {
+                error = "unknown preset \"" + preset.toString() + "\"";
+                return false;
+            }
+        } else {
+            variation.program = juce::jlimit(0, reference.getNumPrograms() - 1, static_cast<int>(preset));
+        }
+
+        const auto impact = json.getProperty("impact", {});
+        if (impact.isArray()) {
+            for (auto& point : *impact.getArray())
+                if (point.size() >= 2)
+                    variation.impact.add({ static_cast<float>(point[0]), static_cast<float>(point[1]) });
+        } else if (! impact.isVoid()) {
+            variation.impact.add({ 0.0f, static_cast<float>(impact) });
+        }
+
+        if (auto* parameters = json.getProperty("parameters", {}).getDynamicObject()) {
+            for (auto& property : parameters->getProperties()) {
+                if (reference.getState().getParameter(property.name.toString()) == nullptr) {
+                    error = "unknown parameter \"" + property.name.toString() + "\"";
+                    return false;
+                }
+
+                variation.parameters.set(property.name, property.value);
+            }
+        }
+
+        if (auto* curves = json.getProperty("curves", {}).getDynamicObject()) {
+            for (auto& property : curves->getProperties()) {
+                auto target = riser::ImpactMapping::numTargets;
+                for (int i = 0; i < riser::ImpactMapping::numTargets; ++i)
+                    if (property.name.toString() == riser::ImpactMapping::getTargetName(static_cast<riser::ImpactMapping::Target>(i)))
+                        target = static_cast<riser::ImpactMapping::Target>(i);
+
+                if (target == riser::ImpactMapping::numTargets) {
+                    error = "unknown mapping target \"" + property.name.toString() + "\"";
+                    return false;
+                }
+
+                variation.curves.emplace_back(target, parseCurve(property.value));
+            }
+        }
+
+        return true;
+    }
+
+    bool loadManifest(const juce::File& file, Manifest& manifest, juce::String& error)
+    {
+        const auto json = juce::JSON::parse(file);
+        if (! json.isObject()) {
+            error = "not a JSON object";
+            return false;
+        }
+
+        const auto directory = file.getParentDirectory();
+
+        if (auto* inputs = json.getProperty("inputs", {}).getArray())
+            for (auto& input : *inputs)
+                manifest.inputs.add(directory.getChildFile(input.toString()));
+
+        manifest.outputDirectory = directory.getChildFile(json.getProperty("outputDirectory", "renders").toString());
+        manifest.tempo = juce::jlimit(20.0, 999.0, static_cast<double>(json.getProperty("tempo", 120.0)));
+        manifest.bitDepth = static_cast<int>(json.getProperty("bitDepth", 24));
+        manifest.maxTailSeconds = juce::jmax(0.0, static_cast<double>(json.getProperty("maxTailSeconds", 10.0)));
+
+        // Preset names and parameter IDs are checked against a real processor up front, so a
+        // typo fails before any rendering starts
+        MiniRiserAudioProcessor reference;
+
+        if (auto* variations = json.getProperty("variations", {}).getArray()) {
+            for (auto& variationJson : *variations) {
+                Variation variation;
+                if (! parseVariation(variationJson, reference, variation, error))
+                    return false;
+
+                manifest.variations.push_back(std::move(variation));
+            }
+        }
+
+        if (manifest.inputs.isEmpty() || manifest.variations.empty()) {
+            error = "needs at least one input and one variation";
+            return false;
+        }
+
+        if (! juce::WavAudioFormat().getPossibleBitDepths().contains(manifest.bitDepth)) {
+            error = "unsupported bit depth " + juce::String(manifest.bitDepth);
+            return false;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    // Every worker owns a deque of tasks and works through it from the front. A worker that
+    // runs dry steals from the back of someone else's, so long files can't leave cores idle
+    // while one worker still has a queue. Tasks are dealt out in contiguous runs, which keeps
+    // the renders of one input on one worker while there is no stealing to do.
+    class WorkStealingScheduler
+    {
+    public:
+        WorkStealingScheduler(int numWorkers, int numTasks)
+            : queues(static_cast<size_t>(numWorkers))
+        {
+            for (int task = 0; task < numTasks; ++task)
+                queues[static_cast<size_t>(task * numWorkers / numTasks)].tasks.push_back(task);
+        }
+
+        bool next(int worker, int& task)
+        {
+            if (popFront(queues[static_cast<size_t>(worker)], task))
+                return true;
+
+            for (size_t offset = 1; offset < queues.size(); ++offset)
+                if (popBack(queues[(static_cast<size_t>(worker) + offset) % queues.size()], task))
+                    return true;
+
+            return false;
+        }
+
+    private:
+        struct Queue {
+            std::mutex lock;
+            std::deque<int> tasks;
+        };
+
+        static bool popFront(Queue& queue, int& task)
+        {
+            const std::lock_guard<std::mutex> lock(queue.lock);
+            if (queue.tasks.empty())
+                return false;
+
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+
+        static bool popBack(Queue& queue, int& task)
+        {
+            const std::lock_guard<std::mutex> lock(queue.lock);
+            if (queue.tasks.empty())
+                return false;
+
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+            return true;
+        }
+
+        std::vector<Queue> queues;
+    };
+
+    //==============================================================================
+    // Always playing, from the start of the file, at the manifest's tempo
+    class Transport : public juce::AudioPlayHead
+    {
+    public:
+        Transport(double tempoToUse, double sampleRateToUse) : tempo(tempoToUse), sampleRate(sampleRateToUse) {}
+
+        void advance(int numSamples) noexcept       { samplePosition += numSamples; }
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            info.setBpm(tempo);
+            info.setTimeSignature(TimeSignature { 4, 4 });
+            info.setTimeInSamples(samplePosition);
+            info.setPpqPosition(static_cast<double>(samplePosition) / sampleRate * tempo / 60.0);
+            info.setIsPlaying(true);
+            return info;
+        }
+
+    private:
+        double tempo, sampleRate;
+        juce::int64 samplePosition = 0;
+    };
+
+    float getImpactAt(const Variation& variation, float position)
+    {
+        const auto& points = variation.impact;
+        if (points.size() == 1 || position <= points.getFirst().x)
+            return points.getFirst().y;
+
+        for (int i = 1; i < points.size(); ++i) {
+            if (position <= points[i].x) {
+                const auto start = points[i - 1];
+                const auto end = points[i];
+                const auto span = end.x - start.x;
+                return span > 0.0f ? start.y + (end.y - start.y) * (position - start.x) / span : end.y;
+            }
+        }
+
+        return points.getLast().y;
+    }
+
+    class Renderer
+    {
+    public:
+        Renderer(const Manifest& manifestToUse, int blockSizeToUse)
+            : manifest(manifestToUse), blockSize(blockSizeToUse)
+        {
+            processor.getStateInformation(initialState);
+        }
+
+        juce::File getOutputFile(const juce::File& input, const Variation& variation) const
+        {
+            return manifest.outputDirectory.getChildFile(input.getFileNameWithoutExtension() + "_" + variation.name + ".wav");
+        }
+
+        bool render(const juce::File& input, const Variation& variation, juce::String& error)
+        {
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader(wav.createMemoryMappedReader(input));
+            if (reader == nullptr || ! reader->mapEntireFile()) {
+                error = "could not map " + input.getFullPathName();
+                return false;
+            }
+
+            const auto numChannels = static_cast<int>(reader->numChannels);
+            const auto sampleRate = reader->sampleRate;
+            const auto inputLength = reader->lengthInSamples;
+
+            // The output file is only created once the input has mapped
+            const auto outputFile = getOutputFile(input, variation);
+            outputFile.deleteFile();
+            auto stream = std::make_unique<juce::FileOutputStream>(outputFile);
+            if (stream->failedToOpen()) {
+                error = "could not create " + outputFile.getFullPathName();
+                return false;
+            }
+
+            std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, static_cast<unsigned int>(numChannels),
+                                                                                manifest.bitDepth, {}, 0));
+            if (writer == nullptr) {
+                error = "could not write " + outputFile.getFullPathName();
+                return false;
+            }
+            stream.release();
+
+            prepare(variation, numChannels, sampleRate);
+            Transport transport(manifest.tempo, sampleRate);
+            processor.setPlayHead(&transport);
+
+            // Output is shifted back by the reported latency and the tail runs until it has been
+            // silent for a while or the manifest's limit is reached
+            const auto latency = processor.getLatencySamples();
+            const auto maxTail = static_cast<juce::int64>(sampleRate * juce::jmin(manifest.maxTailSeconds, processor.getTailLengthSeconds()));
+            const auto silenceToStop = static_cast<juce::int64>(sampleRate * 0.5);
+            const auto lastSample = inputLength + latency + maxTail;
+
+            juce::AudioBuffer<float> block(numChannels, blockSize);
+            juce::MidiBuffer midi;
+            juce::int64 silentRun = 0;
+            bool ok = true;
+
+            for (juce::int64 position = 0; position < lastSample && ok; position += blockSize) {
+                const auto numSamples = static_cast<int>(juce::jmin<juce::int64>(blockSize, lastSample - position));
+                block.setSize(numChannels, numSamples, false, false, true);
+                block.clear();
+
+                if (position < inputLength)
+                    reader->read(&block, 0, static_cast<int>(juce::jmin<juce::int64>(numSamples, inputLength - position)), position, true, true);
+
+                if (! variation.impact.isEmpty()) {
+                    const auto impact = getImpactAt(variation, static_cast<float>(static_cast<double>(position) / static_cast<double>(juce::jmax<juce::int64>(1, inputLength))));
+                    auto* parameter = processor.getState().getParameter("impact");
+                    parameter->setValueNotifyingHost(parameter->convertTo0to1(impact));
+                }
+
+                processor.processBlock(block, midi);
+                transport.advance(numSamples);
+
+                const auto skip = static_cast<int>(juce::jlimit<juce::int64>(0, numSamples, latency - position));
+                if (skip < numSamples)
+                    ok = writer->writeFromAudioSampleBuffer(block, skip, numSamples - skip);
+
+                if (position >= inputLength + latency) {
+                    silentRun = block.getMagnitude(0, numSamples) < 1.0e-6f ? silentRun + numSamples : 0;
+                    if (silentRun >= silenceToStop)
+                        break;
+                }
+            }
+
+            processor.setPlayHead(nullptr);
+            processor.releaseResources();
+
+            if (! ok)
+                error = "write failed for " + outputFile.getFullPathName();
+
+            return ok;
+        }
+
+    private:
+        void prepare(const Variation& variation, int numChannels, double sampleRate)
+        {
+            // Back to the defaults, then the variation on top: state, preset, overrides, curves
+            processor.setStateInformation(initialState.getData(), static_cast<int>(initialState.getSize()));
+            processor.setCurrentProgram(variation.program);
+
+            for (auto& parameter : variation.parameters) {
+                auto* target = processor.getState().getParameter(parameter.name.toString());
+                target->setValueNotifyingHost(target->convertTo0to1(static_cast<float>(parameter.value)));
+            }
+
+            for (auto& [target, curve] : variation.curves)
+                processor.getImpactMapping().setCurve(target, curve);
+
+            processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+        }
+
+        const Manifest& manifest;
+        const int blockSize;
+        MiniRiserAudioProcessor processor;
+        juce::MemoryBlock initialState;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    Options options;
+    if (! parseOptions(args, options))
+        return 1;
+
+    Manifest manifest;
+    juce::String error;
+    if (! loadManifest(options.manifestFile, manifest, error)) {
+        std::cerr << options.manifestFile.getFullPathName() << ": " << error << "\n";
+        return 1;
+    }
+
+    if (! manifest.outputDirectory.createDirectory()) {
+        std::cerr << "Could not create " << manifest.outputDirectory.getFullPathName() << "\n";
+        return 1;
+    }
+
+    const auto numVariations = static_cast<int>(manifest.variations.size());
+    const auto numTasks = manifest.inputs.size() * numVariations;
+    const auto numWorkers = juce::jlimit(1, numTasks, options.numWorkers > 0 ? options.numWorkers : juce::SystemStats::getNumCpus());
+
+    // Processors are built here on the main thread and only used on their worker afterwards
+    std::vector<std::unique_ptr<Renderer>> renderers;
+    for (int i = 0; i < numWorkers; ++i)
+        renderers.push_back(std::make_unique<Renderer>(manifest, options.blockSize));
+
+    WorkStealingScheduler scheduler(numWorkers, numTasks);
+    std::mutex outputLock;
+    std::atomic<int> failures { 0 }, completed { 0 };
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    std::vector<std::thread> workers;
+    for (int worker = 0; worker < numWorkers; ++worker) {
+        workers.emplace_back([&, worker] {
+            auto& renderer = *renderers[static_cast<size_t>(worker)];
+
+            for (int task = 0; scheduler.next(worker, task);) {
+                const auto& input = manifest.inputs.getReference(task / numVariations);
+                const auto& variation = manifest.variations[static_cast<size_t>(task % numVariations)];
+
+                juce::String taskError;
+                const bool ok = renderer.render(input, variation, taskError);
+                if (! ok)
+                    ++failures;
+
+                const std::lock_guard<std::mutex> lock(outputLock);
+                std::printf("[%d/%d] %s %s\n", ++completed, numTasks, ok ? "rendered" : "FAILED",
+                            (ok ? renderer.getOutputFile(input, variation).getFullPathName() : taskError).toRawUTF8());
+                std::fflush(stdout);
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    std::printf("%d file(s) in %.1f s on %d worker(s), %d failed\n", numTasks - failures.load(),
+                (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001, numWorkers, failures.load());
+
+    return failures > 0 ? 1 : 0;
+}
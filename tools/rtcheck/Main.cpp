@@ -0,0 +1,234 @@
+#include <JuceHeader.h>
+#include "../../source/PluginProcessor.h"
+#include "../../source/RealtimeCheck.h"
+
+#include <cstdio>
+#include <iostream>
+
+// Drives MiniRiserAudioProcessor the way a host would during a show: parameters automated
+// between blocks, a transport that starts and stops, mapping curves edited from the message
+// thread. Every processBlock call runs inside a RealtimeCheck scope; any heap allocation, lock
+// or blocking call made there fails the run.
+
+namespace
+{
+    struct Options {
+        juce::Array<int> blockSizes { 32, 100, 512 };
+        juce::Array<double> sampleRates { 48000.0 };
+        double secondsPerCase = 4.0;
+        bool trap = false;
+    };
+
+    template <typename ValueType>
+    juce::Array<ValueType> parseList(const juce::String& text)
+    {
+        juce::Array<ValueType> values;
+        for (auto& token : juce::StringArray::fromTokens(text, ",", {}))
+            if (token.trim().isNotEmpty())
+                values.add(static_cast<ValueType>(token.trim().getDoubleValue()));
+        return values;
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: MiniRiserRealtimeCheck [options]\n"
+                     "  --blocks 32,100,...    Block sizes to test\n"
+                     "  --rates 48000,...      Sample rates to test\n"
+                     "  --seconds <s>          Audio seconds processed per case (default 4)\n"
+                     "  --trap                 Abort at the first violation, to stop in a debugger\n";
+    }
+
+    bool parseOptions(const juce::StringArray& args, Options& options)
+    {
+        for (int i = 0; i < args.size(); ++i) {
+            const auto& arg = args[i];
+            const auto next = [&]() { return i + 1 < args.size() ? args[++i] : juce::String(); };
+
+            if (arg == "--blocks")        options.blockSizes = parseList<int>(next());
+            else if (arg == "--rates")    options.sampleRates = parseList<double>(next());
+            else if (arg == "--seconds")  options.secondsPerCase = next().getDoubleValue();
+            else if (arg == "--trap")     options.trap = true;
+            else {
+                printUsage();
+                return false;
+            }
+        }
+
+        return ! options.blockSizes.isEmpty() && ! options.sampleRates.isEmpty() && options.secondsPerCase > 0.0;
+    }
+
+    // 120 BPM in 4/4, stopping for one bar in every eight so the synced stages see both states
+    class Transport : public juce::AudioPlayHead
+    {
+    public:
+        explicit Transport(double sampleRateToUse) : sampleRate(sampleRateToUse) {}
+
+        void advance(int numSamples) noexcept       { samplePosition += numSamples; }
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            const auto quarterNotes = static_cast<double>(samplePosition) / sampleRate * 2.0;
+
+            PositionInfo info;
+            info.setBpm(120.0);
+            info.setTimeSignature(TimeSignature { 4, 4 });
+            info.setTimeInSamples(samplePosition);
+            info.setPpqPosition(quarterNotes);
+            info.setIsPlaying(std::fmod(quarterNotes, 32.0) < 28.0);
+            return info;
+        }
+
+    private:
+        double sampleRate;
+        juce::int64 samplePosition = 0;
+    };
+
+    struct Case {
+        bool doublePrecision = false;
+        int oversampling = 0;
+        bool lookahead = false;
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+    };
+
+    // Every automatable parameter: Impact follows a triangle that dips to zero so the bypass
+    // state machine goes idle and comes back; the others step through their values
+    void automate(MiniRiserAudioProcessor& processor, double seconds)
+    {
+        static constexpr const char* steppedIds[] = { "crushMode", "crushAntialias", "panShape", "panSync",
+                                                      "delaySync", "riseLength", "riseCurve" };
+
+        auto& state = processor.getState();
+        const auto phase = std::fmod(seconds / 3.0, 1.0);
+        state.getParameter("impact")->setValueNotifyingHost(static_cast<float>(juce::jmax(0.0, 1.0 - std::abs(2.4 * phase - 1.2))));
+
+        for (size_t i = 0; i < std::size(steppedIds); ++i) {
+            auto* parameter = state.getParameter(steppedIds[i]);
+            const auto steps = juce::jmax(2, parameter->getNumSteps());
+            const auto step = static_cast<int>(seconds * 2.0 + static_cast<double>(i)) % steps;
+            parameter->setValueNotifyingHost(static_cast<float>(step) / static_cast<float>(steps - 1));
+        }
+    }
+
+    // Alternates two shapes so the audio thread keeps picking up new tables
+    void editCurves(MiniRiserAudioProcessor& processor, int edit)
+    {
+        using Target = riser::ImpactMapping::Target;
+        auto& mapping = processor.getImpactMapping();
+
+        if (edit % 2 == 0)
+            mapping.setCurve(Target::reverbWet, { { 0.0f, 0.0f }, { 0.5f, 0.8f, 1.0f }, { 1.0f, 0.2f } });
+        else
+            mapping.setCurve(Target::reverbWet, riser::ImpactMapping::getDefaultCurve(Target::reverbWet));
+    }
+
+    template <typename SampleType>
+    void runCase(const Options& options, const Case& testCase)
+    {
+        MiniRiserAudioProcessor processor;
+        Transport transport(testCase.sampleRate);
+
+        const auto setChoice = [&processor](const char* id, int index) {
+            auto* parameter = processor.getState().getParameter(id);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(static_cast<float>(index)));
+        };
+        setChoice("oversampling", testCase.oversampling);
+        setChoice("transientLookahead", testCase.lookahead ? 1 : 0);
+
+        processor.setProcessingPrecision(testCase.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                  : juce::AudioProcessor::singlePrecision);
+        processor.setPlayConfigDetails(2, 2, testCase.sampleRate, testCase.blockSize);
+        processor.setPlayHead(&transport);
+        processor.prepareToPlay(testCase.sampleRate, testCase.blockSize);
+
+        juce::AudioBuffer<SampleType> block(2, testCase.blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(0x5eed);
+
+        const auto numBlocks = juce::jmax(1, static_cast<int>(std::ceil(options.secondsPerCase * testCase.sampleRate / testCase.blockSize)));
+        const auto blocksPerEdit = juce::jmax(1, static_cast<int>(0.5 * testCase.sampleRate / testCase.blockSize));
+
+        for (int i = 0; i < numBlocks; ++i) {
+            // Short bursts of noise with silence between them, so the silence skip is exercised too
+            const auto seconds = static_cast<double>(i) * testCase.blockSize / testCase.sampleRate;
+            const auto level = std::fmod(seconds, 1.0) < 0.6 ? SampleType(0.3) : SampleType(0);
+            for (int channel = 0; channel < block.getNumChannels(); ++channel)
+                for (int sample = 0; sample < block.getNumSamples(); ++sample)
+                    block.setSample(channel, sample, level * static_cast<SampleType>(random.nextFloat() * 2.0f - 1.0f));
+
+            if (i % blocksPerEdit == 0)
+                editCurves(processor, i / blocksPerEdit);
+
+            // Set first, as a host does from its own thread; only the plugin's code is checked
+            automate(processor, seconds);
+
+            {
+                const riser::RealtimeCheck::Scope audioThread;
+                processor.processBlock(block, midi);
+            }
+
+            transport.advance(testCase.blockSize);
+        }
+
+        processor.releaseResources();
+        processor.setPlayHead(nullptr);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    Options options;
+    if (! parseOptions(args, options))
+        return 1;
+
+    if (! riser::RealtimeCheck::isEnabled()) {
+        std::cerr << "Built without MINIRISER_RT_CHECK; nothing would be checked\n";
+        return 1;
+    }
+
+    riser::RealtimeCheck::setTrapOnViolation(options.trap);
+
+    using Check = riser::RealtimeCheck;
+    int failedCases = 0;
+
+    std::printf("%6s %7s %6s %4s %9s %12s %6s %9s\n", "type", "rate", "block", "os", "lookahead", "allocations", "locks", "blocking");
+
+    for (auto sampleRate : options.sampleRates)
+        for (auto blockSize : options.blockSizes)
+            for (int oversampling : { 0, 2 })
+                for (bool lookahead : { false, true })
+                    for (bool doublePrecision : { false, true }) {
+                        const Case testCase { doublePrecision, oversampling, lookahead, sampleRate, blockSize };
+
+                        Check::resetCounts();
+                        if (doublePrecision)
+                            runCase<double>(options, testCase);
+                        else
+                            runCase<float>(options, testCase);
+
+                        const auto allocations = Check::getCount(Check::allocation);
+                        const auto locks = Check::getCount(Check::lock);
+                        const auto blockingCalls = Check::getCount(Check::blockingCall);
+                        if (allocations + locks + blockingCalls > 0)
+                            ++failedCases;
+
+                        std::printf("%6s %7.0f %6d %3dx %9s %12d %6d %9d\n", doublePrecision ? "double" : "float",
+                                    sampleRate, blockSize, 1 << oversampling, lookahead ? "on" : "off",
+                                    allocations, locks, blockingCalls);
+                        std::fflush(stdout);
+                    }
+
+    if (failedCases > 0) {
+        std::printf("%d case(s) broke real-time safety\n", failedCases);
+        return 1;
+    }
+
+    std::printf("No real-time violations\n");
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <JuceHeader.h>
+#include "../../source/PluginProcessor.h"
+
+#include <iostream>
+
+// Loads hand-built states of every binary format version, and the XML states saved before it,
+// into a fresh processor and checks what comes back, along with program recall. Exits
+// non-zero on the first mismatch; run by CTest.
+
+namespace
+{
+    int failures = 0;
+
+    void expect(bool condition, const char* what)
+    {
+        if (! condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ++failures;
+        }
+    }
+
+    float getPlainValue(MiniRiserAudioProcessor& processor, const char* parameterId)
+    {
+        auto* parameter = processor.getState().getParameter(parameterId);
+        return parameter->convertFrom0to1(parameter->getValue());
+    }
+
+    bool curvesEqual(const riser::ImpactMapping::Curve& a, const riser::ImpactMapping::Curve& b)
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].tension != b[i].tension)
+                return false;
+
+        return true;
+    }
+
+    bool hasDefaultCurves(MiniRiserAudioProcessor& processor)
+    {
+        using Mapping = riser::ImpactMapping;
+
+        for (int target = 0; target < Mapping::numTargets; ++target)
+            if (! curvesEqual(processor.getImpactMapping().getCurve(static_cast<Mapping::Target>(target)),
+                              Mapping::getDefaultCurve(static_cast<Mapping::Target>(target))))
+                return false;
+
+        return true;
+    }
+
+    // A version 1 state: parameter entries only, no curves section
+    juce::MemoryBlock makeVersion1State()
+    {
+        juce::MemoryBlock data;
+        juce::MemoryOutputStream stream(data, false);
+        stream.writeInt(riser::StateFormat::magic);
+        stream.writeInt(1);
+        stream.writeInt(2);
+        stream.writeCompressedInt(3);
+        stream.writeString("impact");
+        stream.writeFloat(42.0f);
+        stream.writeString("crushMode");
+        stream.writeFloat(1.0f);
+        stream.writeString("retiredParameter");
+        stream.writeFloat(7.0f);
+        return data;
+    }
+
+    void checkVersion1()
+    {
+        MiniRiserAudioProcessor processor;
+
+        // Starts from edited curves, so a migration that left them alone would show
+        processor.getImpactMapping().setCurve(riser::ImpactMapping::reverbWet, { { 0.0f, 1.0f }, { 1.0f, 1.0f } });
+
+        const auto data = makeVersion1State();
+        processor.setStateInformation(data.getData(), static_cast<int>(data.getSize()));
+
+        expect(std::abs(getPlainValue(processor, "impact") - 42.0f) < 0.05f, "v1: impact restored");
+        expect(getPlainValue(processor, "crushMode") == 1.0f, "v1: crushMode restored");
+        expect(processor.getCurrentProgram() == 2, "v1: program restored");
+        expect(hasDefaultCurves(processor), "v1: migrated to the default curves");
+    }
+
+    void checkRoundTrip()
+    {
+        using Mapping = riser::ImpactMapping;
+        const Mapping::Curve edited { { 0.0f, 0.0f }, { 0.5f, 0.8f, 1.0f }, { 1.0f, 0.2f } };
+
+        juce::MemoryBlock data;
+        {
+            MiniRiserAudioProcessor source;
+            source.getState().getParameter("impact")->setValueNotifyingHost(0.25f);
+            source.getImpactMapping().setCurve(Mapping::reverbWet, edited);
+            source.getStateInformation(data);
+        }
+
+        MiniRiserAudioProcessor processor;
+        processor.setStateInformation(data.getData(), static_cast<int>(data.getSize()));
+
+        expect(std::abs(getPlainValue(processor, "impact") - 25.0f) < 0.05f, "v2: impact restored");
+        expect(curvesEqual(processor.getImpactMapping().getCurve(Mapping::reverbWet), edited), "v2: edited curve restored");
+        expect(curvesEqual(processor.getImpactMapping().getCurve(Mapping::delayWet), Mapping::getDefaultCurve(Mapping::delayWet)),
+               "v2: untouched curve restored");
+    }
+
+    // A session saved before the binary format: the parameter tree as XML via copyXmlToBinary
+    void checkLegacyXml()
+    {
+        juce::MemoryBlock data;
+        {
+            MiniRiserAudioProcessor source;
+            source.getState().getParameter("impact")->setValueNotifyingHost(0.6f);
+            source.getState().getParameter("crushMode")->setValueNotifyingHost(1.0f);
+            juce::AudioProcessor::copyXmlToBinary(*source.getState().copyState().createXml(), data);
+        }
+
+        MiniRiserAudioProcessor processor;
+        processor.setCurrentProgram(3);
+        processor.getImpactMapping().setCurve(riser::ImpactMapping::reverbWet, { { 0.0f, 1.0f }, { 1.0f, 1.0f } });
+        processor.setStateInformation(data.getData(), static_cast<int>(data.getSize()));
+
+        expect(std::abs(getPlainValue(processor, "impact") - 60.0f) < 0.05f, "xml: impact restored");
+        expect(getPlainValue(processor, "crushMode") == 1.0f, "xml: crushMode restored");
+        expect(processor.getCurrentProgram() == 0, "xml: program reset");
+        expect(hasDefaultCurves(processor), "xml: default curves");
+    }
+
+    // Selecting the current program again must recall it over any edits
+    void checkProgramRecall()
+    {
+        MiniRiserAudioProcessor processor;
+        processor.setCurrentProgram(2);
+
+        expect(processor.getCurrentProgram() == 2, "program: selected");
+        expect(std::abs(getPlainValue(processor, "impact") - 60.0f) < 0.05f, "program: impact applied");
+        expect(getPlainValue(processor, "panSync") == 3.0f, "program: panSync applied");
+        expect(getPlainValue(processor, "delaySync") == 2.0f, "program: delaySync applied");
+
+        processor.getState().getParameter("impact")->setValueNotifyingHost(0.1f);
+        processor.getState().getParameter("delaySync")->setValueNotifyingHost(0.0f);
+        processor.setCurrentProgram(2);
+
+        expect(std::abs(getPlainValue(processor, "impact") - 60.0f) < 0.05f, "program: impact recalled");
+        expect(getPlainValue(processor, "delaySync") == 2.0f, "program: delaySync recalled");
+    }
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    checkVersion1();
+    checkRoundTrip();
+    checkLegacyXml();
+    checkProgramRecall();
+
+    if (failures > 0)
+        return 1;
+
+    std::cout << "State format checks passed\n";
+    return 0;
+}
@@ -0,0 +1,490 @@
+#include <JuceHeader.h>
+#include "../../source/PluginProcessor.h"
+
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Headless stream stage for Linux: raw interleaved PCM in on stdin (or a Unix socket), the
+// processed stream out on stdout, no GUI and no audio device. Three threads form a pipeline
+// over a fixed pool of preallocated blocks: the reader fills a block and converts it to
+// planar audio, the processor runs MiniRiserAudioProcessor on it in place, and the writer
+// converts it back and writes it out. Stages hand each other block indices through lock-free
+// queues, so audio is never copied between them and nothing is allocated once streaming.
+//
+// Impact and other parameters can be changed while streaming through a datagram control
+// socket, one command per line:
+//     impact 75
+//     set riseLength 2
+// or from an automation file of timed changes, applied at the first block at or after their
+// time in the stream:
+//     # seconds  parameter  value
+//     0.0        impact     0
+//     8.0        impact     100
+
+namespace
+{
+    enum class SampleFormat { float32, int16 };
+
+    struct Options {
+        double sampleRate = 48000.0;
+        int numChannels = 2;
+        int blockSize = 256;
+        int numBlocks = 4;
+        SampleFormat format = SampleFormat::float32;
+        juce::String inputSocket;
+        juce::String controlSocket;
+        juce::File automationFile;
+    };
+
+    std::atomic<bool> stopRequested { false };
+
+    void printUsage()
+    {
+        std::cerr << "Usage: MiniRiserStream [options] < input.raw > output.raw\n"
+                     "  --rate <hz>            Sample rate (default 48000)\n"
+                     "  --channels <n>         Interleaved channels (default 2)\n"
+                     "  --block <frames>       Frames per block (default 256)\n"
+                     "  --blocks <n>           Blocks in the pool (default 4)\n"
+                     "  --format f32|s16       Little-endian sample format (default f32)\n"
+                     "  --input <path>         Accept one connection on this Unix socket instead of reading stdin\n"
+                     "  --control <path>       Datagram socket for control commands\n"
+                     "  --automation <file>    Timed parameter changes\n";
+    }
+
+    bool parseOptions(const juce::StringArray& args, Options& options)
+    {
+        for (int i = 0; i < args.size(); ++i) {
+            const auto& arg = args[i];
+            const auto next = [&]() { return i + 1 < args.size() ? args[++i] : juce::String(); };
+
+            if (arg == "--rate")              options.sampleRate = next().getDoubleValue();
+            else if (arg == "--channels")     options.numChannels = next().getIntValue();
+            else if (arg == "--block")        options.blockSize = next().getIntValue();
+            else if (arg == "--blocks")       options.numBlocks = next().getIntValue();
+            else if (arg == "--format")       options.format = next() == "s16" ? SampleFormat::int16 : SampleFormat::float32;
+            else if (arg == "--input")        options.inputSocket = next();
+            else if (arg == "--control")      options.controlSocket = next();
+            else if (arg == "--automation")   options.automationFile = juce::File::getCurrentWorkingDirectory().getChildFile(next());
+            else {
+                printUsage();
+                return false;
+            }
+        }
+
+        return options.sampleRate > 0.0 && options.blockSize > 0 && options.numBlocks >= 2
+            && juce::isPositiveAndBelow(options.numChannels, 17);
+    }
+
+    //==============================================================================
+    struct AutomationEvent {
+        juce::int64 samplePosition = 0;
+        juce::String parameterId;
+        float value = 0.0f;
+    };
+
+    bool loadAutomation(const juce::File& file, double sampleRate, std::vector<AutomationEvent>& events)
+    {
+        juce::StringArray lines;
+        file.readLines(lines);
+
+        for (auto line : lines) {
+            line = line.upToFirstOccurrenceOf("#", false, false).trim();
+            if (line.isEmpty())
+                continue;
+
+            const auto tokens = juce::StringArray::fromTokens(line, false);
+            if (tokens.size() != 3) {
+                std::cerr << "Bad automation line: " << line << "\n";
+                return false;
+            }
+
+            events.push_back({ static_cast<juce::int64>(tokens[0].getDoubleValue() * sampleRate), tokens[1], tokens[2].getFloatValue() });
+        }
+
+        std::stable_sort(events.begin(), events.end(), [](const auto& a, const auto& b) { return a.samplePosition < b.samplePosition; });
+        return true;
+    }
+
+    // Safe from any thread: parameter values are atomics the audio thread reads
+    bool setParameter(MiniRiserAudioProcessor& processor, const juce::String& parameterId, float plainValue)
+    {
+        auto* parameter = processor.getState().getParameter(parameterId);
+        if (parameter == nullptr)
+            return false;
+
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+        return true;
+    }
+
+    //==============================================================================
+    struct Block {
+        juce::HeapBlock<char> raw;
+        juce::AudioBuffer<float> audio;
+        int numFrames = 0;
+        bool endOfStream = false;
+    };
+
+    // Single-producer, single-consumer queue of block indices. The consumer sleeps on an event
+    // while it's empty, so idle stages don't spin.
+    class BlockQueue
+    {
+    public:
+        explicit BlockQueue(int capacity) : fifo(capacity + 1), slots(static_cast<size_t>(capacity + 1)) {}
+
+        void push(int blockIndex) noexcept
+        {
+            int start1, size1, start2, size2;
+            fifo.prepareToWrite(1, start1, size1, start2, size2);
+            jassert (size1 + size2 == 1);     // The queues hold every block, so they can't overflow
+            slots[static_cast<size_t>(size1 > 0 ? start1 : start2)] = blockIndex;
+            fifo.finishedWrite(1);
+            ready.signal();
+        }
+
+        bool pop(int& blockIndex) noexcept
+        {
+            for (;;) {
+                int start1, size1, start2, size2;
+                fifo.prepareToRead(1, start1, size1, start2, size2);
+
+                if (size1 + size2 > 0) {
+                    blockIndex = slots[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+                    fifo.finishedRead(1);
+                    return true;
+                }
+
+                if (stopRequested)
+                    return false;
+
+                ready.wait(100);
+            }
+        }
+
+    private:
+        juce::AbstractFifo fifo;
+        std::vector<int> slots;
+        juce::WaitableEvent ready;
+    };
+
+    //==============================================================================
+    class Stream
+    {
+    public:
+        Stream(const Options& optionsToUse, MiniRiserAudioProcessor& processorToUse, int inputFileToUse,
+               std::vector<AutomationEvent> automationToUse)
+            : options(optionsToUse), processor(processorToUse), inputFile(inputFileToUse),
+              automation(std::move(automationToUse)),
+              bytesPerFrame(options.numChannels * (options.format == SampleFormat::float32 ? 4 : 2)),
+              blocks(static_cast<size_t>(options.numBlocks)),
+              freeBlocks(options.numBlocks), filledBlocks(options.numBlocks), processedBlocks(options.numBlocks)
+        {
+            for (int i = 0; i < options.numBlocks; ++i) {
+                auto& block = blocks[static_cast<size_t>(i)];
+                block.raw.allocate(static_cast<size_t>(options.blockSize * bytesPerFrame), true);
+                block.audio.setSize(options.numChannels, options.blockSize);
+                freeBlocks.push(i);
+            }
+        }
+
+        // Returns once the input has ended and every block has been written, or on a stop request
+        void run()
+        {
+            std::thread reader([this] { readLoop(); });
+            std::thread writer([this] { writeLoop(); });
+            processLoop();
+
+            reader.join();
+            writer.join();
+        }
+
+    private:
+        void readLoop()
+        {
+            for (int index = 0; freeBlocks.pop(index);) {
+                auto& block = blocks[static_cast<size_t>(index)];
+                const auto bytesRead = readFully(block.raw.getData(), static_cast<size_t>(options.blockSize * bytesPerFrame));
+
+                block.numFrames = static_cast<int>(bytesRead / static_cast<size_t>(bytesPerFrame));
+                block.endOfStream = block.numFrames < options.blockSize;
+                deinterleave(block);
+                filledBlocks.push(index);
+
+                if (block.endOfStream)
+                    return;
+            }
+        }
+
+        void processLoop()
+        {
+            juce::MidiBuffer midi;
+            size_t nextEvent = 0;
+
+            for (int index = 0; filledBlocks.pop(index);) {
+                auto& block = blocks[static_cast<size_t>(index)];
+
+                for (; nextEvent < automation.size() && automation[nextEvent].samplePosition <= streamPosition; ++nextEvent)
+                    setParameter(processor, automation[nextEvent].parameterId, automation[nextEvent].value);
+
+                if (block.numFrames > 0) {
+                    // Views the first numFrames of the block's own channels; nothing is copied
+                    juce::AudioBuffer<float> view(block.audio.getArrayOfWritePointers(), options.numChannels, block.numFrames);
+
+                    // Like a host: no processing while the processor is suspended for a latency change
+                    const juce::ScopedLock lock(processor.getCallbackLock());
+                    if (processor.isSuspended())
+                        view.clear();
+                    else
+                        processor.processBlock(view, midi);
+                }
+
+                streamPosition += block.numFrames;
+                processedBlocks.push(index);
+
+                if (block.endOfStream)
+                    return;
+            }
+        }
+
+        void writeLoop()
+        {
+            for (int index = 0; processedBlocks.pop(index);) {
+                auto& block = blocks[static_cast<size_t>(index)];
+                interleave(block);
+
+                if (! writeFully(block.raw.getData(), static_cast<size_t>(block.numFrames * bytesPerFrame)))
+                    stopRequested = true;
+
+                const bool last = block.endOfStream;
+                freeBlocks.push(index);
+
+                if (last || stopRequested)
+                    break;
+            }
+
+            juce::MessageManager::getInstance()->stopDispatchLoop();
+        }
+
+        //==============================================================================
+        size_t readFully(char* destination, size_t numBytes) const
+        {
+            size_t done = 0;
+            while (done < numBytes && ! stopRequested) {
+                // The stop signal may land on any thread, so don't block in read() indefinitely
+                pollfd input { inputFile, POLLIN, 0 };
+                if (::poll(&input, 1, 100) == 0)
+                    continue;
+
+                const auto result = ::read(inputFile, destination + done, numBytes - done);
+                if (result <= 0) {
+                    if (result < 0 && errno == EINTR)
+                        continue;
+                    break;
+                }
+
+                done += static_cast<size_t>(result);
+            }
+
+            return done;
+        }
+
+        static bool writeFully(const char* source, size_t numBytes)
+        {
+            size_t done = 0;
+            while (done < numBytes) {
+                const auto result = ::write(STDOUT_FILENO, source + done, numBytes - done);
+                if (result <= 0) {
+                    if (result < 0 && errno == EINTR)
+                        continue;
+                    return false;
+                }
+
+                done += static_cast<size_t>(result);
+            }
+
+            return true;
+        }
+
+        void deinterleave(Block& block) const
+        {
+            for (int channel = 0; channel < options.numChannels; ++channel) {
+                auto* destination = block.audio.getWritePointer(channel);
+
+                if (options.format == SampleFormat::float32) {
+                    const auto* source = reinterpret_cast<const float*>(block.raw.getData()) + channel;
+                    for (int frame = 0; frame < block.numFrames; ++frame)
+                        destination[frame] = source[frame * options.numChannels];
+                } else {
+                    const auto* source = reinterpret_cast<const juce::int16*>(block.raw.getData()) + channel;
+                    for (int frame = 0; frame < block.numFrames; ++frame)
+                        destination[frame] = static_cast<float>(source[frame * options.numChannels]) * (1.0f / 32768.0f);
+                }
+            }
+        }
+
+        void interleave(Block& block) const
+        {
+            for (int channel = 0; channel < options.numChannels; ++channel) {
+                const auto* source = block.audio.getReadPointer(channel);
+
+                if (options.format == SampleFormat::float32) {
+                    auto* destination = reinterpret_cast<float*>(block.raw.getData()) + channel;
+                    for (int frame = 0; frame < block.numFrames; ++frame)
+                        destination[frame * options.numChannels] = source[frame];
+                } else {
+                    auto* destination = reinterpret_cast<juce::int16*>(block.raw.getData()) + channel;
+                    for (int frame = 0; frame < block.numFrames; ++frame)
+                        destination[frame * options.numChannels] = static_cast<juce::int16>(juce::jlimit(-32768, 32767, juce::roundToInt(source[frame] * 32768.0f)));
+                }
+            }
+        }
+
+        const Options& options;
+        MiniRiserAudioProcessor& processor;
+        const int inputFile;
+        const std::vector<AutomationEvent> automation;
+        const int bytesPerFrame;
+
+        std::vector<Block> blocks;
+        BlockQueue freeBlocks, filledBlocks, processedBlocks;
+        juce::int64 streamPosition = 0;
+    };
+
+    //==============================================================================
+    int bindUnixSocket(const juce::String& path, int type)
+    {
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        if (path.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+            return -1;
+
+        path.copyToUTF8(address.sun_path, sizeof(address.sun_path));
+        ::unlink(address.sun_path);
+
+        const auto fd = ::socket(AF_UNIX, type, 0);
+        if (fd < 0)
+            return -1;
+
+        if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    int acceptInputConnection(const juce::String& path)
+    {
+        const auto listener = bindUnixSocket(path, SOCK_STREAM);
+        if (listener < 0 || ::listen(listener, 1) != 0)
+            return -1;
+
+        std::cerr << "Waiting for input on " << path << "\n";
+        const auto connection = ::accept(listener, nullptr, nullptr);
+        ::close(listener);
+        return connection;
+    }
+
+    void controlLoop(int socket, MiniRiserAudioProcessor& processor)
+    {
+        char message[256];
+
+        while (! stopRequested) {
+            const auto size = ::recv(socket, message, sizeof(message) - 1, 0);
+            if (size <= 0) {
+                if (size < 0 && errno == EINTR)
+                    continue;
+                break;
+            }
+
+            message[size] = 0;
+            for (auto& line : juce::StringArray::fromLines(juce::String::fromUTF8(message))) {
+                const auto tokens = juce::StringArray::fromTokens(line.trim(), false);
+                const bool ok = (tokens.size() == 2 && tokens[0] == "impact" && setParameter(processor, "impact", tokens[1].getFloatValue()))
+                             || (tokens.size() == 3 && tokens[0] == "set" && setParameter(processor, tokens[1], tokens[2].getFloatValue()));
+
+                if (! ok && line.trim().isNotEmpty())
+                    std::cerr << "Ignoring control command: " << line << "\n";
+            }
+        }
+    }
+
+    void handleStopSignal(int)
+    {
+        stopRequested = true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    Options options;
+    if (! parseOptions(args, options))
+        return 1;
+
+    struct sigaction action {};
+    action.sa_handler = handleStopSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<AutomationEvent> automation;
+    if (options.automationFile != juce::File() && ! loadAutomation(options.automationFile, options.sampleRate, automation))
+        return 1;
+
+    MiniRiserAudioProcessor processor;
+    processor.setPlayConfigDetails(options.numChannels, options.numChannels, options.sampleRate, options.blockSize);
+    processor.prepareToPlay(options.sampleRate, options.blockSize);
+    std::cerr << "MiniRiserStream: " << options.numChannels << " ch at " << options.sampleRate << " Hz, "
+              << options.blockSize << "-frame blocks, plugin latency " << processor.getLatencySamples() << " frames\n";
+
+    int controlSocket = -1;
+    std::thread control;
+    if (options.controlSocket.isNotEmpty()) {
+        controlSocket = bindUnixSocket(options.controlSocket, SOCK_DGRAM);
+        if (controlSocket < 0) {
+            std::cerr << "Could not bind control socket " << options.controlSocket << "\n";
+            return 1;
+        }
+
+        control = std::thread([&] { controlLoop(controlSocket, processor); });
+    }
+
+    const auto inputFile = options.inputSocket.isNotEmpty() ? acceptInputConnection(options.inputSocket) : STDIN_FILENO;
+    if (inputFile < 0) {
+        std::cerr << "Could not open input socket " << options.inputSocket << "\n";
+        return 1;
+    }
+
+    // The message thread stays here so latency changes requested over the control socket are
+    // applied; the writer stops the loop once the stream has ended
+    Stream stream(options, processor, inputFile, std::move(automation));
+    std::thread streaming([&] { stream.run(); });
+    juce::MessageManager::getInstance()->runDispatchLoop();
+    streaming.join();
+
+    stopRequested = true;
+    if (control.joinable()) {
+        ::shutdown(controlSocket, SHUT_RDWR);
+        control.join();
+        ::close(controlSocket);
+        ::unlink(options.controlSocket.toRawUTF8());
+    }
+
+    if (inputFile != STDIN_FILENO)
+        ::close(inputFile);
+
+    processor.releaseResources();
+    return 0;
+}